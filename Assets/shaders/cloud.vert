@@ -6,8 +6,6 @@ layout (location = 2) in vec2 texCoords;
 layout (location = 3) in vec3 tangent;
 layout (location = 4) in vec3 bitangent;
 
-layout (location = 6) in mat4 instanceModelMatrix;
-
 out VS_OUT {
     vec2 TexCoords;
     vec3 FragPos;
@@ -17,6 +15,7 @@ out VS_OUT {
     vec4 FragPosLightSpace;
 } vs_out;
 
+#include "instancing.glsl"
 #include "matrices.glsl"
 
 uniform float time;
@@ -28,12 +27,12 @@ void main() {
     pos.y += cos(time) * 5;
     pos.z += sin(time) * 10;
 
-    vec4 modelPos = instanceModelMatrix * vec4(pos, 1.0);
+    vec4 modelPos = instanceModel * vec4(pos, 1.0);
     gl_Position = matrices.projection * matrices.view * modelPos;
     vs_out.FragPos = vec3(modelPos);
-    vs_out.Normal = mat3(transpose(inverse(instanceModelMatrix))) * normal;
-    vs_out.Tangent = mat3(transpose(inverse(instanceModelMatrix))) * tangent;
-    vs_out.Bitangent = mat3(transpose(inverse(instanceModelMatrix))) * bitangent;
+    vs_out.Normal = mat3(transpose(inverse(instanceModel))) * normal;
+    vs_out.Tangent = mat3(transpose(inverse(instanceModel))) * tangent;
+    vs_out.Bitangent = mat3(transpose(inverse(instanceModel))) * bitangent;
     vs_out.TexCoords = texCoords;
     vs_out.FragPosLightSpace = matrices.lightSpaceMatrix * modelPos;
 }
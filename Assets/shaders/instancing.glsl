@@ -0,0 +1,13 @@
+// per instance attributes streamed by InstanceBatcher
+layout (location = 6) in mat4 instanceModel;
+layout (location = 10) in vec4 instanceColor;
+// damage, time
+layout (location = 11) in vec4 instanceParams;
+
+// set by the batcher so the same program can draw single models and instanced batches
+uniform bool instanced = false;
+uniform mat4 model;
+
+mat4 getModelMatrix() {
+    return instanced ? instanceModel : model;
+}
@@ -1,43 +1,58 @@
 #ifndef _lighting_h_
 #define _lighting_h_
 
-uniform sampler2D shadowMap;
+uniform sampler2DArray shadowMap;
 
 #include "lights.glsl"
+#include "shadows.glsl"
 
 /*
 * https://learnopengl.com/Advanced-Lighting/Shadows/Shadow-Mapping
+* https://learnopengl.com/Guest-Articles/2021/CSM
 */
-float ShadowCalculation(vec4 fragPosLightSpace) {
+float ShadowCalculation(vec3 fragPos) {
+    float viewDepth = getViewDepth();
+
+    int cascade = -1;
+    for (int i = 0; i < NR_CASCADES; i++) {
+        if (viewDepth < shadows.cascadeSplits[i]) {
+            cascade = i;
+            break;
+        }
+    }
+
+    // past the last cascade
+    if (cascade == -1) {
+        return 0.0;
+    }
+
+    vec4 fragPosLightSpace = shadows.lightSpaceMatrices[cascade] * vec4(fragPos, 1.0);
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
     projCoords = projCoords * 0.5 + 0.5;
 
-    float closestDepth = texture(shadowMap, projCoords.xy).r;
+    if (projCoords.z > 1.0) {
+        return 0.0;
+    }
 
     float currentDepth = projCoords.z;
 
     vec3 normal = normalize(fs_in.Normal);
-    float bias = max(0.05 * (1.0 - dot(normal, lights.sun.direction)), 0.005);
+    // cascades further out cover more world per texel so need more bias
+    float bias = max(0.005 * (1.0 - dot(normal, lights.sun.direction)), 0.0005) * (cascade + 1);
 
     float shadow = 0.0;
-    float texelSize = 1.0 / textureSize(shadowMap, 0).x;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
 
     const int numSamples = 16;
     for (int i = -numSamples/2; i <= numSamples/2; ++i)
     {
         for (int j = -numSamples/2; j <= numSamples/2; ++j)
         {
-            float pcfDepth = texture(shadowMap, projCoords.xy + vec2(i, j) * texelSize).r;
+            float pcfDepth = texture(shadowMap, vec3(projCoords.xy + vec2(i, j) * texelSize, cascade)).r;
             shadow += currentDepth - bias > pcfDepth  ? 1.0 : 0.0;
         }
     }
-    shadow /= float(numSamples * numSamples);
-
-    shadow = clamp(shadow + bias, 0.0, 1.0);
-
-    if (projCoords.z > 1.0) {
-        shadow = 0.0;
-    }
+    shadow /= float((numSamples + 1) * (numSamples + 1));
 
     return shadow;
 }
@@ -118,13 +133,14 @@ vec3 calculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir
 
 vec3 calculateLighting(vec3 fragPos, vec3 normal, vec3 viewPos, vec3 color, float shininess) {
     vec3 viewDir = normalize(viewPos - fragPos);
-    float shadow = ShadowCalculation(fs_in.FragPosLightSpace);
+    float shadow = ShadowCalculation(fs_in.FragPos);
     normal = normalize(normal);
 
     vec3 lighting = calculateDirectionalLight(lights.sun, normal, viewDir, color, shininess, shadow);
 
-    for (int i = 0; i < lights.pointLightsCount; i++) {
-        lighting += calculatePointLight(lights.pointLights[i], normal, fragPos, viewDir, color, shininess, shadow);
+    uvec2 cluster = getCluster();
+    for (uint i = 0u; i < cluster.y; i++) {
+        lighting += calculatePointLight(getClusterLight(cluster, i), normal, fragPos, viewDir, color, shininess, shadow);
     }
 
     // lighting += calculateSpotLight(lights.spotLight, normal, fragPos, viewDir, color, shininess, shadow);
@@ -140,8 +156,9 @@ vec3 calculateLightingBasic(vec3 fragPos, vec3 normal, vec3 viewPos, vec3 color,
 
     vec3 lighting = calculateDirectionalLight(lights.sun, normal, viewDir, color, shininess, 0.0);
 
-    for (int i = 0; i < lights.pointLightsCount; i++) {
-        lighting += calculatePointLight(lights.pointLights[i], normal, fragPos, viewDir, color, shininess, 0.0);
+    uvec2 cluster = getCluster();
+    for (uint i = 0u; i < cluster.y; i++) {
+        lighting += calculatePointLight(getClusterLight(cluster, i), normal, fragPos, viewDir, color, shininess, 0.0);
     }
 
     // lighting += calculateSpotLight(lights.spotLight, normal, fragPos, viewDir, color, shininess, 0.0);
@@ -164,8 +181,9 @@ vec3 calculateTerrainLighting(vec3 fragPos, vec3 normal, vec3 viewPos, vec3 colo
     float lightFactor = max(dot(lights.sun.direction, vec3(0.0, 1.0, 0.0)), 0.1);
     lighting *= lightFactor;
 
-    for (int i = 0; i < lights.pointLightsCount; i++) {
-        lighting += calculatePointLight(lights.pointLights[i], normal, fragPos, viewDir, color, 32.0, shadow);
+    uvec2 cluster = getCluster();
+    for (uint i = 0u; i < cluster.y; i++) {
+        lighting += calculatePointLight(getClusterLight(cluster, i), normal, fragPos, viewDir, color, 32.0, shadow);
     }
 
     return lighting;
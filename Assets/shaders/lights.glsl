@@ -34,15 +34,67 @@ struct SpotLight {
     float outerCutOff;
 };
 
-#define NR_POINT_LIGHTS 12
-
-struct Lights {
+// layout mirrored by utils/Lights.h, keep the two in sync
+layout(std140) uniform Lights {
     DirectionalLight sun;
-    PointLight pointLights[NR_POINT_LIGHTS];
-    int pointLightsCount;
     SpotLight spotLight;
-};
+    uvec4 clusterGrid;
+    vec4 clusterDepth;
+    vec2 screenSize;
+} lights;
+
+/*
+* https://www.aortiz.me/2018/12/21/CG.html
+*/
+// point lights binned per cluster on the cpu by LightClusters
+uniform samplerBuffer pointLightBuffer;
+uniform usamplerBuffer clusterGridBuffer;
+uniform usamplerBuffer clusterIndexBuffer;
+
+PointLight getPointLight(uint index) {
+    int base = int(index) * 5;
+
+    vec4 specular = texelFetch(pointLightBuffer, base + 3);
+    vec4 attenuation = texelFetch(pointLightBuffer, base + 4);
+
+    PointLight light;
+    light.position = texelFetch(pointLightBuffer, base).xyz;
+    light.ambient = texelFetch(pointLightBuffer, base + 1).xyz;
+    light.diffuse = texelFetch(pointLightBuffer, base + 2).xyz;
+    light.specular = specular.xyz;
+    light.constant = specular.w;
+    light.linear = attenuation.x;
+    light.quadratic = attenuation.y;
+
+    return light;
+}
+
+// linear view space depth of this fragment under the camera projection
+float getViewDepth() {
+    float near = lights.clusterDepth.x;
+    float far = lights.clusterDepth.y;
+
+    float ndcDepth = gl_FragCoord.z * 2.0 - 1.0;
+    return (2.0 * near * far) / (far + near - ndcDepth * (far - near));
+}
+
+// offset and count into the cluster index list for this fragment
+uvec2 getCluster() {
+    float viewDepth = getViewDepth();
+
+    uint slice = uint(max(log(viewDepth) * lights.clusterDepth.z + lights.clusterDepth.w, 0.0));
+    slice = min(slice, lights.clusterGrid.z - 1u);
+
+    uvec2 tile = uvec2(gl_FragCoord.xy / lights.screenSize * vec2(lights.clusterGrid.xy));
+    tile = min(tile, lights.clusterGrid.xy - 1u);
+
+    uint index = tile.x + tile.y * lights.clusterGrid.x + slice * lights.clusterGrid.x * lights.clusterGrid.y;
+
+    return texelFetch(clusterGridBuffer, int(index)).xy;
+}
 
-uniform Lights lights;
+PointLight getClusterLight(uvec2 cluster, uint i) {
+    return getPointLight(texelFetch(clusterIndexBuffer, int(cluster.x + i)).r);
+}
 
 #endif
\ No newline at end of file
@@ -14,6 +14,7 @@ in VS_OUT {
     vec3 Tangent;
     vec3 Bitangent;
     vec4 FragPosLightSpace;
+    vec3 Color;
 } fs_in;
 
 uniform Material material;
@@ -21,12 +22,10 @@ uniform Material material;
 #include "lighting.frag"
 #include "camera.glsl"
 
-uniform vec3 color;
-
 out vec4 FragColor;
 
 void main() {
-    vec3 result = calculateLighting(fs_in.FragPos, fs_in.Normal, camera.position, material.diffuse.rgb * color, material
+    vec3 result = calculateLighting(fs_in.FragPos, fs_in.Normal, camera.position, material.diffuse.rgb * fs_in.Color, material
     .shininess);
 
     FragColor = vec4(result, 1.0);
@@ -13,13 +13,17 @@ out VS_OUT {
     vec3 Tangent;
     vec3 Bitangent;
     vec4 FragPosLightSpace;
+    vec3 Color;
 } vs_out;
 
-uniform mat4 model;
-
+#include "instancing.glsl"
 #include "matrices.glsl"
 
+uniform vec3 color = vec3(1.0);
+
 void main() {
+    mat4 model = getModelMatrix();
+
     vs_out.TexCoords = aTexCoords;
     vs_out.FragPos = vec3(model * vec4(aPos, 1.0));
     gl_Position = matrices.projection * matrices.view * model * vec4(aPos, 1.0);
@@ -27,4 +31,5 @@ void main() {
     vs_out.Tangent = mat3(transpose(inverse(model))) * aTangent;
     vs_out.Bitangent = mat3(transpose(inverse(model))) * aBitangent;
     vs_out.FragPosLightSpace = matrices.lightSpaceMatrix * vec4(vs_out.FragPos, 1.0);
+    vs_out.Color = instanced ? instanceColor.rgb : color;
 }
\ No newline at end of file
@@ -4,11 +4,11 @@ layout(location = 0) in vec3 aPos;
 
 uniform mat4 view;
 uniform mat4 projection;
-uniform mat4 model;
 
+#include "instancing.glsl"
 #include "matrices.glsl"
 
 void main()
 {
-    gl_Position = matrices.projection * matrices.view * model * vec4(aPos, 1.0);
+    gl_Position = matrices.projection * matrices.view * getModelMatrix() * vec4(aPos, 1.0);
 }
\ No newline at end of file
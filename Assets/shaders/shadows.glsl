@@ -0,0 +1,16 @@
+#ifndef _shadows_h_
+#define _shadows_h_
+
+/*
+ * https://learnopengl.com/Guest-Articles/2021/CSM
+ */
+
+#define NR_CASCADES 4
+
+// layout mirrored by ShadowBuffer::Cascades, keep the two in sync
+layout(std140) uniform Shadows {
+    mat4 lightSpaceMatrices[NR_CASCADES];
+    vec4 cascadeSplits;
+} shadows;
+
+#endif
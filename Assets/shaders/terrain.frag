@@ -38,7 +38,7 @@ bool isOnPath(vec3 fragPos, vec3 pathedPoint, vec3 nextPathedPoint) {
 void main() {
     vec3 color = grassColor;
 
-    float shadow = ShadowCalculation(fs_in.FragPosLightSpace);
+    float shadow = ShadowCalculation(fs_in.FragPos);
 
     vec3 lighting = calculateTerrainLighting(fs_in.FragPos, fs_in.Normal, camera.position, color, shadow);
 
@@ -21,6 +21,8 @@ in VS_OUT {
     vec3 Tangent;
     vec3 Bitangent;
     vec4 FragPosLightSpace;
+    float Damage;
+    float Time;
 } fs_in;
 
 #include "lighting.frag"
@@ -28,7 +30,6 @@ in VS_OUT {
 
 uniform sampler2D damageTexture;
 uniform Material material;
-uniform float damage = 0.0;
 
 
 void main() {
@@ -37,7 +38,7 @@ void main() {
     vec3 result = calculateLighting(fs_in.FragPos, fs_in.Normal, camera.position, texColor.xyz, material.shininess);
 
     float damageFactor = texture(damageTexture, fs_in.TexCoords).r;
-    result *= mix(1.0, damageFactor, damage);
+    result *= mix(1.0, damageFactor, fs_in.Damage);
 
     FragColor = vec4(result, texColor.a);
 }
\ No newline at end of file
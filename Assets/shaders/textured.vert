@@ -14,13 +14,19 @@ out VS_OUT {
     vec3 Tangent;
     vec3 Bitangent;
     vec4 FragPosLightSpace;
+    float Damage;
+    float Time;
 } vs_out;
 
-uniform mat4 model;
-
+#include "instancing.glsl"
 #include "matrices.glsl"
 
+uniform float damage = 0.0;
+uniform float time = 0.0;
+
 void main() {
+    mat4 model = getModelMatrix();
+
     gl_Position = matrices.projection * matrices.view * model * vec4(aPos, 1.0);
     vs_out.TexCoords = aTexCoords;
 
@@ -31,4 +37,7 @@ void main() {
     vs_out.Normal = mat3(transpose(inverse(model))) * aNormal;
     vs_out.Tangent = mat3(transpose(inverse(model))) * aTangent;
     vs_out.Bitangent = mat3(transpose(inverse(model))) * aBitangent;
+
+    vs_out.Damage = instanced ? instanceParams.x : damage;
+    vs_out.Time = instanced ? instanceParams.y : time;
 }
\ No newline at end of file
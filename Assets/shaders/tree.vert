@@ -6,8 +6,6 @@ layout (location = 2) in vec2 texCoords;
 layout (location = 3) in vec3 tangent;
 layout (location = 4) in vec3 bitangent;
 
-layout (location = 6) in mat4 instanceModelMatrix;
-
 out VS_OUT {
     vec2 TexCoords;
     vec3 FragPos;
@@ -17,15 +15,16 @@ out VS_OUT {
     vec4 FragPosLightSpace;
 } vs_out;
 
+#include "instancing.glsl"
 #include "matrices.glsl"
 
 void main() {
-    gl_Position = matrices.projection * matrices.view * instanceModelMatrix * vec4(position, 1.0);;
+    gl_Position = matrices.projection * matrices.view * instanceModel * vec4(position, 1.0);;
     vs_out.TexCoords = texCoords;
-    vs_out.FragPos = vec3(instanceModelMatrix * vec4(position, 1.0));
-    vs_out.Normal = mat3(transpose(inverse(instanceModelMatrix))) * normal;
-    vs_out.Tangent = mat3(transpose(inverse(instanceModelMatrix))) * tangent;
-    vs_out.Bitangent = mat3(transpose(inverse(instanceModelMatrix))) * bitangent;
+    vs_out.FragPos = vec3(instanceModel * vec4(position, 1.0));
+    vs_out.Normal = mat3(transpose(inverse(instanceModel))) * normal;
+    vs_out.Tangent = mat3(transpose(inverse(instanceModel))) * tangent;
+    vs_out.Bitangent = mat3(transpose(inverse(instanceModel))) * bitangent;
     vs_out.FragPosLightSpace = matrices.lightSpaceMatrix * vec4(vs_out.FragPos, 1.0);
 }
 
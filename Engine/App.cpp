@@ -9,6 +9,8 @@
 #include <print>
 
 #include "imgui/imgui.h"
+#include "renderables/SceneGraph.h"
+#include "utils/Allocations.h"
 #include "utils/PlayerManager.h"
 #include <GLFW/glfw3.h>
 #include <GL/glew.h>
@@ -20,6 +22,7 @@ void setupGLFW();
 View App::view;
 bool App::paused = false;
 bool App::debug = false;
+bool App::headless = false;
 
 auto App::init() -> bool {
     setupGLFW();
@@ -106,6 +109,11 @@ void App::debugInterface() {
 
     if (debug) {
         ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+        ImGui::Text("Scene graph: %zu nodes, %zu recomputed", SceneGraph::Size(), SceneGraph::Recomputed());
+#ifdef CW_ALLOCATION_TRACKING
+        ImGui::Text("Heap: %.1f MB live, %.1f MB peak", static_cast<float>(Allocations::Live()) / 1048576.0F,
+                    static_cast<float>(Allocations::Peak()) / 1048576.0F);
+#endif
     }
 
     ImGui::End();
@@ -9,6 +9,9 @@
 
 #include "Config.h"
 #include "View.h"
+#include "utils/Allocations.h"
+#include "utils/FrameArena.h"
+#include "utils/Profiler.h"
 
 namespace App {
     extern View view;
@@ -17,6 +20,9 @@ namespace App {
 
     extern bool debug;
 
+    // no window or gl context, anything that would touch gl has to check this first
+    extern bool headless;
+
     auto init() -> bool;
 
     auto window(const std::string &title,
@@ -35,11 +41,24 @@ namespace App {
     void loop(F &&func, Args &&... args) {
         finalise();
         while (!view.shouldClose()) {
-            View::pollEvents();
+            PROFILE_FRAME();
+            ALLOCATION_FRAME();
+            FrameArena::GetInstance().swap();
+
+            {
+                PROFILE_ZONE("Events");
+                View::pollEvents();
+            }
+
             if (!paused) {
+                PROFILE_ZONE("Update");
                 func(std::forward<Args>(args)...);
             }
+
             view.render();
+
+            // blocks on vsync, so this is mostly waiting
+            PROFILE_ZONE("Swap");
             view.swapBuffers();
         }
     }
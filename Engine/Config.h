@@ -5,6 +5,8 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include <cstddef>
+
 #include <glm/ext/vector_float3.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
 
@@ -16,6 +18,8 @@ namespace Config {
             static_cast<float>(DEFAULT_WIDTH) / static_cast<float>(DEFAULT_HEIGHT);
     constexpr auto IDENTITY_MATRIX = glm::mat4(1.0F);
     constexpr auto ZERO_VECTOR = glm::vec3(0.0F);
+    // what GpuMemory lets buffers, textures and render targets add up to before it asserts
+    constexpr std::size_t GPU_MEMORY_BUDGET = 1024ULL * 1024ULL * 1024ULL;
 } // namespace Config
 
 #endif // CONFIG_H
@@ -0,0 +1,234 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#include "Replay.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <print>
+#include <random>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "App.h"
+
+namespace {
+    template<typename T>
+    auto ParseValue(const std::string_view text, T &value) -> bool {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    // the bit a key is stored in, nothing if it isn't recorded
+    auto Bit(const int key) -> std::optional<std::uint32_t> {
+        const auto found = std::ranges::find(Replay::KEYS, key);
+        if (found == Replay::KEYS.end()) {
+            return std::nullopt;
+        }
+
+        return 1U << static_cast<std::uint32_t>(std::distance(Replay::KEYS.begin(), found));
+    }
+}
+
+namespace Replay {
+    auto ParseArguments(const std::span<char *const> arguments) -> std::optional<Settings> {
+        std::optional<Settings> settings;
+        std::optional<std::uint32_t> seed;
+
+        for (std::size_t i = 1; i + 1 < arguments.size(); i++) {
+            const std::string_view argument = arguments[i];
+            const std::string_view value = arguments[i + 1];
+
+            if (argument == "--record" || argument == "--replay") {
+                if (settings.has_value()) {
+                    std::println(stderr, "Only one of --record and --replay can be used, ignoring {}", argument);
+                } else {
+                    settings = Settings{argument == "--record" ? Mode::RECORD : Mode::REPLAY, value};
+                }
+            } else if (argument == "--seed") {
+                if (std::uint32_t parsed = 0; ParseValue(value, parsed)) {
+                    seed = parsed;
+                }
+            } else {
+                continue;
+            }
+
+            i++;
+        }
+
+        // only used when recording, a replay always takes the one in the log
+        if (settings.has_value() && settings->mode == Mode::RECORD) {
+            settings->seed = seed;
+        }
+
+        return settings;
+    }
+
+    auto Session::open(Settings value) -> bool {
+        settings = std::move(value);
+        header = {};
+        frames.clear();
+        next = 0;
+        events.clear();
+        nextEvent = 0;
+        applied.clear();
+        requested.clear();
+
+        if (settings.mode == Mode::RECORD) {
+            header.seed = settings.seed.value_or(std::random_device()());
+            return true;
+        }
+
+        if (settings.mode != Mode::REPLAY) {
+            return true;
+        }
+
+        std::ifstream file(settings.path, std::ios::binary);
+        file.read(reinterpret_cast<char *>(&header), sizeof(Header));
+
+        if (!file || header.magic != MAGIC) {
+            std::println(stderr, "{} is not a replay", settings.path.string());
+            return false;
+        }
+
+        if (header.version != VERSION) {
+            std::println(stderr, "{} is version {}, expected {}", settings.path.string(), header.version, VERSION);
+            return false;
+        }
+
+        // the counts come from the file, so they have to fit in what's left of it before anything is sized by them
+        std::error_code error;
+        const std::uintmax_t size = std::filesystem::file_size(settings.path, error);
+        const std::uintmax_t available = !error && size > sizeof(Header) ? size - sizeof(Header) : 0;
+
+        if (header.frames > available / sizeof(Frame) ||
+            header.events > (available - header.frames * sizeof(Frame)) / sizeof(Event)) {
+            std::println(stderr, "{} is cut short", settings.path.string());
+            return false;
+        }
+
+        frames.resize(header.frames);
+        events.resize(header.events);
+        file.read(reinterpret_cast<char *>(frames.data()), static_cast<std::streamsize>(frames.size() * sizeof(Frame)));
+        file.read(reinterpret_cast<char *>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(Event)));
+
+        if (!file) {
+            std::println(stderr, "{} is cut short", settings.path.string());
+            return false;
+        }
+
+        if (!std::ranges::is_sorted(events, {}, &Event::frame)) {
+            std::println(stderr, "{} has its events out of order", settings.path.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    auto Session::frame(const float deltaTime) -> float {
+        applied.clear();
+
+        if (settings.mode == Mode::REPLAY) {
+            current = next < frames.size() ? frames[next++] : Frame{};
+
+            for (; nextEvent < events.size() && events[nextEvent].frame < next; nextEvent++) {
+                applied.push_back(events[nextEvent]);
+            }
+
+            return current.deltaTime;
+        }
+
+        current = std::exchange(pending, {});
+        current.deltaTime = deltaTime;
+        applied.swap(requested);
+
+        if (settings.mode == Mode::RECORD) {
+            for (Event &event: applied) {
+                event.frame = static_cast<std::uint32_t>(frames.size());
+            }
+
+            frames.push_back(current);
+            events.insert(events.end(), applied.begin(), applied.end());
+        }
+
+        return deltaTime;
+    }
+
+    auto Session::key(const int key) -> bool {
+        const auto bit = Bit(key);
+
+        if (settings.mode == Mode::REPLAY) {
+            return bit.has_value() && (current.keys & *bit) != 0U;
+        }
+
+        const bool pressed = App::view.getKey(key) == GLFW_PRESS;
+
+        if (settings.mode == Mode::RECORD && pressed && bit.has_value() && !frames.empty()) {
+            frames.back().keys |= *bit;
+        }
+
+        return pressed;
+    }
+
+    void Session::mouse(const float x, const float y) {
+        pending.mouseX += x;
+        pending.mouseY += y;
+    }
+
+    void Session::scroll(const float y) {
+        pending.scroll += y;
+    }
+
+    void Session::request(const Change change, const std::int32_t value) {
+        if (settings.mode != Mode::REPLAY) {
+            requested.push_back({0, change, value});
+        }
+    }
+
+    auto Session::getSeed() const -> std::optional<std::uint32_t> {
+        if (settings.mode == Mode::NONE) {
+            return std::nullopt;
+        }
+
+        return header.seed;
+    }
+
+    auto Session::isFinished() const -> bool {
+        return settings.mode == Mode::REPLAY && next >= frames.size();
+    }
+
+    auto Session::save() const -> bool {
+        if (settings.mode != Mode::RECORD) {
+            return true;
+        }
+
+        Header written = header;
+        written.frames = static_cast<std::uint32_t>(frames.size());
+        written.events = static_cast<std::uint32_t>(events.size());
+
+        std::ofstream file(settings.path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(&written), sizeof(Header));
+        file.write(reinterpret_cast<const char *>(frames.data()),
+                   static_cast<std::streamsize>(frames.size() * sizeof(Frame)));
+        file.write(reinterpret_cast<const char *>(events.data()),
+                   static_cast<std::streamsize>(events.size() * sizeof(Event)));
+
+        if (!file) {
+            std::println(stderr, "Could not write {}", settings.path.string());
+            return false;
+        }
+
+        std::println("Recorded {} frames with seed {} to {}", frames.size(), header.seed, settings.path.string());
+        return true;
+    }
+}
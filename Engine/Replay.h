@@ -0,0 +1,149 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_REPLAY_H
+#define CW_REPLAY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/ext/vector_float2.hpp>
+
+// records the seed, frame times and input of a session so it can be played back exactly, for profiling
+// the same heavy scenario again or comparing builds. anything else on the command line, --stress and its
+// counts included, has to be passed again when replaying. the pause menu's switches are recorded as events,
+// its tuning sliders aren't and are greyed out while a session is recording or replaying
+namespace Replay {
+    constexpr std::array<char, 4> MAGIC = {'C', 'W', 'R', 'P'};
+    constexpr std::uint32_t VERSION = 2;
+
+    // every key processInput reads, a frame stores one bit for each in this order
+    constexpr std::array KEYS = {
+        GLFW_KEY_ESCAPE, GLFW_KEY_Q, GLFW_KEY_LEFT_CONTROL, GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D,
+        GLFW_KEY_LEFT_SHIFT, GLFW_KEY_SPACE, GLFW_KEY_N
+    };
+
+    struct Header {
+        std::array<char, 4> magic = MAGIC;
+        std::uint32_t version = VERSION;
+        std::uint32_t seed = 0;
+        std::uint32_t frames = 0;
+        std::uint32_t events = 0;
+    };
+
+    struct Frame {
+        float deltaTime = 0.0F;
+        // summed over every mouse and scroll event since the frame before
+        float mouseX = 0.0F;
+        float mouseY = 0.0F;
+        float scroll = 0.0F;
+        std::uint32_t keys = 0;
+    };
+
+    // what a pause menu event changes
+    enum class Change : std::uint32_t {
+        // value is the player's index in name order
+        PLAYER,
+        THIRD_PERSON,
+        CARS_PAUSED,
+    };
+
+    struct Event {
+        // the frame it's applied at the start of
+        std::uint32_t frame = 0;
+        Change change = Change::PLAYER;
+        std::int32_t value = 0;
+    };
+
+    static_assert(sizeof(Header) == 20 && sizeof(Frame) == 20 && sizeof(Event) == 12,
+                  "the file is the header, every frame then every event");
+    static_assert(KEYS.size() <= 32, "one bit per key");
+
+    enum class Mode {
+        NONE,
+        RECORD,
+        REPLAY,
+    };
+
+    struct Settings {
+        Mode mode = Mode::NONE;
+        std::filesystem::path path;
+        // recording only, a random one when --seed isn't given
+        std::optional<std::uint32_t> seed;
+    };
+
+    // --record path [--seed n] or --replay path, nothing when neither is there
+    [[nodiscard]] auto ParseArguments(std::span<char *const> arguments) -> std::optional<Settings>;
+
+    // sits between glfw and the game, live input goes through it when recording and the log replaces it
+    // when replaying. without a mode it passes everything straight through
+    class Session {
+    public:
+        Session() = default;
+
+        // a replay reads the whole log up front, false if it couldn't
+        auto open(Settings value) -> bool;
+
+        // called at the start of each rendered frame with the measured time, returns the one to use
+        auto frame(float deltaTime) -> float;
+
+        // only the keys in KEYS are recorded, anything else reads as released during a replay
+        [[nodiscard]] auto key(int key) -> bool;
+
+        // from the view's callbacks, held until the next frame so recording and replay apply them at the
+        // same point
+        void mouse(float x, float y);
+
+        void scroll(float y);
+
+        [[nodiscard]] auto getMouse() const -> glm::vec2 { return {current.mouseX, current.mouseY}; }
+
+        [[nodiscard]] auto getScroll() const -> float { return current.scroll; }
+
+        // a switch flipped in the pause menu, held until the next frame like the mouse. ignored during a
+        // replay, the log's events stand in for it
+        void request(Change change, std::int32_t value);
+
+        // the changes to apply this frame, in the order they were made
+        [[nodiscard]] auto getEvents() const -> std::span<const Event> { return applied; }
+
+        // the seed to give Random before anything is built
+        [[nodiscard]] auto getSeed() const -> std::optional<std::uint32_t>;
+
+        [[nodiscard]] auto getMode() const -> Mode { return settings.mode; }
+
+        // a replay has used every frame in the log
+        [[nodiscard]] auto isFinished() const -> bool;
+
+        // writes the log when recording
+        auto save() const -> bool;
+
+    private:
+        Settings settings;
+        Header header;
+
+        std::vector<Frame> frames;
+        std::size_t next = 0;
+
+        std::vector<Event> events;
+        std::size_t nextEvent = 0;
+
+        Frame current;
+        // mouse and scroll arriving before the frame they belong to
+        Frame pending;
+
+        std::vector<Event> applied;
+        std::vector<Event> requested;
+    };
+}
+
+#endif //CW_REPLAY_H
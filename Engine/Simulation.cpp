@@ -0,0 +1,354 @@
+//
+// Created by Jacob Edwards on 21/05/2024.
+//
+
+#include "Simulation.h"
+
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <print>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include <glm/ext/vector_float3.hpp>
+
+#include "ecs/Adapter.h"
+#include "ecs/Components.h"
+#include "graphics/Color.h"
+#include "physics/Collisions.h"
+#include "renderables/Particle.h"
+#include "renderables/SceneGraph.h"
+#include "renderables/objects/Player.h"
+#include "utils/Allocations.h"
+#include "utils/FrameArena.h"
+#include "utils/PlayerManager.h"
+#include "utils/Profiler.h"
+
+namespace {
+    // adds its lifetime to one of the phase totals
+    class Stopwatch {
+    public:
+        explicit Stopwatch(float &total) : total(total), start(std::chrono::high_resolution_clock::now()) {
+        }
+
+        ~Stopwatch() {
+            const auto end = std::chrono::high_resolution_clock::now();
+            total += std::chrono::duration<float, std::milli>(end - start).count();
+        }
+
+        Stopwatch(const Stopwatch &) = delete;
+
+        auto operator=(const Stopwatch &) -> Stopwatch & = delete;
+
+    private:
+        float &total;
+        std::chrono::high_resolution_clock::time_point start;
+    };
+
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+    void Hash(std::uint64_t &hash, const std::uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            hash ^= (value >> (i * 8)) & 0xFFU;
+            hash *= FNV_PRIME;
+        }
+    }
+
+    void Hash(std::uint64_t &hash, const float value) {
+        Hash(hash, std::bit_cast<std::uint32_t>(value));
+    }
+
+    void Hash(std::uint64_t &hash, const glm::vec3 &value) {
+        Hash(hash, value.x);
+        Hash(hash, value.y);
+        Hash(hash, value.z);
+    }
+
+    template<typename T>
+    auto ParseValue(const std::string_view text, T &value) -> bool {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    void PrintPhase(const std::string_view name, const float total, const std::size_t ticks) {
+        std::println("{:<28}{:>12.3f}{:>16.3f}", name, total, total * 1000.0F / static_cast<float>(ticks));
+    }
+}
+
+namespace Simulation {
+    void Link(World &world) {
+        for (const auto &car: world.cars) {
+            ECS::Adapter::Link(world.registry, *car);
+        }
+    }
+
+    void Step(World &world, const float deltaTime) {
+        PlayerManager &playerManager = PlayerManager::GetInstance();
+        ParticleSystem &particleSystem = ParticleSystem::GetInstance();
+        const auto player = playerManager.getCurrent();
+        const auto &cars = world.cars;
+
+        {
+            PROFILE_ZONE("Player collisions");
+            ALLOCATION_SCOPE(PHYSICS);
+            const Stopwatch stopwatch(world.timings.players);
+
+            for (const auto &car: cars) {
+                car->clearTrackablePositions();
+
+                if (car == player->getCar() && player->getMode() != Player::Mode::DUEL) {
+                    continue;
+                }
+
+                if (Physics::Collisions::check(*player, *car)) {
+                    if (car == player->getCar()) {
+                        player->startDriving(true);
+                    }
+
+                    const auto collisionPoint = Physics::Collisions::getCollisionPoint(*player, *car);
+                    Physics::Collisions::resolve(*player, *car, collisionPoint);
+
+                    player->collisionResponse();
+                    if (player->getMode() != Player::Mode::FREE) {
+                        car->collisionResponse();
+                    }
+
+                    particleSystem.generate(player->attributes.position - collisionPoint,
+                                            player->attributes.velocity, Color::SILVER);
+                } else {
+                    player->attributes.isColliding = false;
+                    car->attributes.isColliding = false;
+                }
+            }
+        }
+
+        {
+            const Stopwatch stopwatch(world.timings.particles);
+            particleSystem.update(deltaTime);
+        }
+
+        {
+            PROFILE_ZONE("Car collisions");
+            ALLOCATION_SCOPE(PHYSICS);
+            const Stopwatch stopwatch(world.timings.cars);
+
+            // each box is copied in once, so the pair loop only reads packed colliders
+            ECS::Adapter::Pull(world.registry);
+
+            auto &pool = world.registry.pool<ECS::Collider>();
+            auto &linked = world.registry.pool<ECS::Linked>();
+            const auto colliders = pool.getComponents();
+            const auto ids = pool.getIds();
+
+            // a miss clears both cars' colliding flag. the clear is held back until the car is next
+            // touched, which ends up the same as clearing it straight away without reaching the car
+            auto &cleared = world.cleared;
+            cleared.assign(colliders.size(), 0U);
+
+            const auto flush = [&](const std::size_t slot) {
+                if (cleared[slot] != 0U) {
+                    linked.get(ids[slot]).entity->attributes.isColliding = false;
+                    cleared[slot] = 0U;
+                }
+            };
+
+            for (std::size_t i = 0; i < colliders.size(); i++) {
+                for (std::size_t j = i + 1; j < colliders.size(); j++) {
+                    if (!colliders[i].overlaps(colliders[j])) {
+                        cleared[i] = 1U;
+                        cleared[j] = 1U;
+                        continue;
+                    }
+
+                    flush(i);
+                    flush(j);
+
+                    Entity &a = *linked.get(ids[i]).entity;
+                    Entity &b = *linked.get(ids[j]).entity;
+
+                    const auto collisionPoint = Physics::Collisions::getCollisionPoint(a, b);
+                    Physics::Collisions::resolve(a, b, collisionPoint);
+
+                    particleSystem.generate(a.attributes.position - collisionPoint, a.attributes.velocity,
+                                            Color::SILVER);
+
+                    a.collisionResponse();
+                    b.collisionResponse();
+                }
+            }
+
+            for (std::size_t slot = 0; slot < colliders.size(); slot++) {
+                flush(slot);
+            }
+        }
+
+        {
+            PROFILE_ZONE("Terrain and wall collisions");
+            ALLOCATION_SCOPE(PHYSICS);
+            const Stopwatch stopwatch(world.timings.terrain);
+
+            const ProceduralTerrain &terrain = *world.terrain;
+
+            for (const auto &[name, other]: playerManager.getAll()) {
+                if (Physics::Collisions::check(*other, terrain)) {
+                    Physics::Collisions::resolve(*other, terrain);
+                    other->attributes.isGrounded = true;
+                } else {
+                    other->attributes.isGrounded = false;
+                }
+            }
+
+            for (const auto &car: cars) {
+                if (Physics::Collisions::check(*car, terrain)) {
+                    Physics::Collisions::resolve(*car, terrain);
+                    car->attributes.isGrounded = true;
+                } else {
+                    car->attributes.isGrounded = false;
+                }
+            }
+
+            for (const Walls::Wall &wall: world.walls) {
+                if (Physics::Collisions::check(player->getBoundingBox(), wall.box)) {
+                    Physics::Collisions::resolve(*player, wall.normal);
+                }
+            }
+
+            for (const auto &car: cars) {
+                for (const Walls::Wall &wall: world.walls) {
+                    if (Physics::Collisions::check(car->getBoundingBox(), wall.box)) {
+                        Physics::Collisions::resolve(*car, wall.normal);
+                    }
+                }
+            }
+        }
+
+        {
+            PROFILE_ZONE("Entities");
+            ALLOCATION_SCOPE(AI);
+            const Stopwatch stopwatch(world.timings.entities);
+
+            for (const auto &entity: world.entities) {
+                entity->update(deltaTime);
+            }
+        }
+
+        {
+            // everything has moved for the tick, settle the hierarchy once rather than on the first draw
+            PROFILE_ZONE("Scene graph");
+            SceneGraph::Update();
+        }
+    }
+
+    auto Checksum(const World &world) -> std::uint64_t {
+        std::uint64_t hash = FNV_OFFSET;
+
+        for (const auto &entity: world.entities) {
+            Hash(hash, entity->attributes.position);
+            Hash(hash, entity->attributes.velocity);
+            Hash(hash, entity->attributes.rotation);
+        }
+
+        for (const auto &car: world.cars) {
+            Hash(hash, static_cast<std::uint32_t>(car->getLaps()));
+        }
+
+        const auto &particles = ParticleSystem::GetInstance().getParticles();
+        Hash(hash, static_cast<std::uint32_t>(particles.size()));
+
+        for (const auto &particle: particles) {
+            Hash(hash, particle.position);
+            Hash(hash, particle.life);
+        }
+
+        return hash;
+    }
+
+    auto ParseArguments(const std::span<char *const> arguments) -> std::optional<Settings> {
+        std::optional<Settings> settings;
+
+        for (std::size_t i = 1; i < arguments.size(); i++) {
+            const std::string_view argument = arguments[i];
+
+            if (argument == "--headless") {
+                settings.emplace();
+            }
+        }
+
+        if (!settings.has_value()) {
+            return settings;
+        }
+
+        // a bad value is reported and left at its default, the run still goes ahead
+        for (std::size_t i = 1; i + 1 < arguments.size(); i++) {
+            const std::string_view argument = arguments[i];
+            const std::string_view value = arguments[i + 1];
+
+            if (argument == "--ticks") {
+                if (std::size_t ticks = 0; ParseValue(value, ticks) && ticks > 0) {
+                    settings->ticks = ticks;
+                } else {
+                    std::println(stderr, "Invalid tick count '{}'", value);
+                }
+            } else if (argument == "--dt") {
+                if (float deltaTime = 0.0F; ParseValue(value, deltaTime) && deltaTime > 0.0F) {
+                    settings->deltaTime = deltaTime;
+                } else {
+                    std::println(stderr, "Invalid delta time '{}'", value);
+                }
+            } else if (argument == "--seed") {
+                if (std::uint32_t seed = 0; ParseValue(value, seed)) {
+                    settings->seed = seed;
+                } else {
+                    std::println(stderr, "Invalid seed '{}'", value);
+                }
+            } else {
+                continue;
+            }
+
+            i++;
+        }
+
+        return settings;
+    }
+
+    auto RunHeadless(World &world, const Settings &settings) -> int {
+        world.timings = {};
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        for (std::size_t tick = 0; tick < settings.ticks; tick++) {
+            PROFILE_FRAME();
+            ALLOCATION_FRAME();
+            FrameArena::GetInstance().swap();
+            Step(world, settings.deltaTime);
+        }
+
+        const auto end = std::chrono::high_resolution_clock::now();
+        const float total = std::chrono::duration<float, std::milli>(end - start).count();
+
+        std::println("Headless run: {} ticks at {:.3f} ms, seed {}", settings.ticks, settings.deltaTime * 1000.0F,
+                     settings.seed);
+        std::println("{:<28}{:>12}{:>16}", "Phase", "Total (ms)", "Per tick (us)");
+
+        PrintPhase("Player collisions", world.timings.players, settings.ticks);
+        PrintPhase("Particles", world.timings.particles, settings.ticks);
+        PrintPhase("Car collisions", world.timings.cars, settings.ticks);
+        PrintPhase("Terrain and wall collisions", world.timings.terrain, settings.ticks);
+        PrintPhase("Entities", world.timings.entities, settings.ticks);
+        PrintPhase("Total", total, settings.ticks);
+
+        std::println("Ticks per second: {:.1f}", static_cast<float>(settings.ticks) * 1000.0F / total);
+        std::println("Particles alive: {}", ParticleSystem::GetInstance().getParticles().size());
+        std::println("Checksum: {:016x}", Checksum(world));
+
+        return 0;
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by Jacob Edwards on 21/05/2024.
+//
+
+#ifndef CW_SIMULATION_H
+#define CW_SIMULATION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "ecs/Registry.h"
+#include "renderables/Entity.h"
+#include "renderables/objects/BumperCar.h"
+#include "renderables/objects/ProceduralTerrain.h"
+#include "renderables/objects/Walls.h"
+
+// the per tick update, shared by the game loop and the headless runner so a headless run simulates
+// exactly what the game does. nothing in here draws or needs a gl context
+namespace Simulation {
+    // milliseconds spent in each phase, summed over every step
+    struct Timings {
+        float players = 0.0F;
+        float particles = 0.0F;
+        float cars = 0.0F;
+        float terrain = 0.0F;
+        float entities = 0.0F;
+    };
+
+    struct World {
+        std::vector<std::shared_ptr<BumperCar> > cars;
+        // everything updated each tick, the cars and players included
+        std::vector<std::shared_ptr<Entity> > entities;
+        std::shared_ptr<ProceduralTerrain> terrain;
+        std::array<Walls::Wall, 4> walls;
+        Timings timings;
+        // the cars linked in by Link, their colliders are what the car pass reads
+        ECS::Registry registry;
+        // one flag per car collider, kept between ticks so the car pass doesn't allocate
+        std::vector<std::uint8_t> cleared;
+    };
+
+    struct Settings {
+        std::size_t ticks = 3600;
+        float deltaTime = 1.0F / 60.0F;
+        std::uint32_t seed = 1;
+    };
+
+    // puts the cars into the world's registry, once after the world is built and before the first step
+    void Link(World &world);
+
+    // collisions, particles and entity updates for one tick, the players come from the player manager
+    void Step(World &world, float deltaTime);
+
+    // fnv-1a over the cars, players and particles, two runs only match if they simulated the same thing
+    [[nodiscard]] auto Checksum(const World &world) -> std::uint64_t;
+
+    // --headless [--ticks n] [--dt seconds] [--seed n], nothing when --headless isn't there
+    [[nodiscard]] auto ParseArguments(std::span<char *const> arguments) -> std::optional<Settings>;
+
+    // steps the world at a fixed delta time and prints what each phase cost and the final checksum
+    auto RunHeadless(World &world, const Settings &settings) -> int;
+}
+
+#endif //CW_SIMULATION_H
@@ -0,0 +1,257 @@
+//
+// Created by Jacob Edwards on 22/05/2024.
+//
+
+#include "StressTest.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <print>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float3.hpp>
+
+#include "Config.h"
+#include "ecs/Components.h"
+#include "graphics/Color.h"
+#include "utils/Random.h"
+
+namespace {
+    // every mode a car can be given without a player driving it
+    constexpr std::array MODES = {
+        BumperCar::Mode::AUTO, BumperCar::Mode::PATHED, BumperCar::Mode::RANDOM, BumperCar::Mode::FOLLOW,
+        BumperCar::Mode::TRACK, BumperCar::Mode::NONE
+    };
+
+    // just inside the walls
+    constexpr float ARENA = 90.0F;
+
+    constexpr std::array PERCENTILES = {0.5F, 0.9F, 0.99F};
+
+    template<typename T>
+    auto ParseValue(const std::string_view text, T &value) -> bool {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    template<typename T>
+    void Parse(const std::string_view argument, const std::string_view text, T &value) {
+        if (T parsed{}; ParseValue(text, parsed) && parsed >= T{}) {
+            value = parsed;
+        } else {
+            std::println(stderr, "Invalid value '{}' for {}", text, argument);
+        }
+    }
+
+    // nearest rank on an already sorted list
+    auto Percentile(const std::span<const float> sorted, const float percentile) -> float {
+        if (sorted.empty()) {
+            return 0.0F;
+        }
+
+        const auto rank = static_cast<std::size_t>(std::ceil(percentile * static_cast<float>(sorted.size())));
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    struct Summary {
+        std::array<float, PERCENTILES.size()> percentiles{};
+        float max = 0.0F;
+    };
+
+    auto Summarise(std::vector<float> samples) -> Summary {
+        std::ranges::sort(samples);
+
+        Summary summary;
+        for (std::size_t i = 0; i < PERCENTILES.size(); i++) {
+            summary.percentiles[i] = Percentile(samples, PERCENTILES[i]);
+        }
+        summary.max = samples.empty() ? 0.0F : samples.back();
+
+        return summary;
+    }
+}
+
+namespace StressTest {
+    auto ParseArguments(const std::span<char *const> arguments) -> std::optional<Settings> {
+        std::optional<Settings> settings;
+
+        for (std::size_t i = 1; i < arguments.size(); i++) {
+            if (std::string_view(arguments[i]) == "--stress") {
+                settings.emplace();
+            }
+        }
+
+        if (!settings.has_value()) {
+            return settings;
+        }
+
+        for (std::size_t i = 1; i + 1 < arguments.size(); i++) {
+            const std::string_view argument = arguments[i];
+            const std::string_view value = arguments[i + 1];
+
+            if (argument == "--cars") {
+                Parse(argument, value, settings->cars);
+            } else if (argument == "--emitters") {
+                Parse(argument, value, settings->emitters);
+            } else if (argument == "--fires") {
+                Parse(argument, value, settings->fires);
+            } else if (argument == "--trees") {
+                Parse(argument, value, settings->trees);
+            } else if (argument == "--clouds") {
+                Parse(argument, value, settings->clouds);
+            } else if (argument == "--chunks") {
+                Parse(argument, value, settings->chunks);
+            } else if (argument == "--duration") {
+                Parse(argument, value, settings->duration);
+            } else if (argument == "--warmup") {
+                Parse(argument, value, settings->warmUp);
+            } else if (argument == "--seed") {
+                Parse(argument, value, settings->seed);
+            } else if (argument == "--log") {
+                settings->log = value;
+            } else {
+                continue;
+            }
+
+            i++;
+        }
+
+        // the terrain needs at least one chunk to stand on
+        settings->chunks = std::max(settings->chunks, 1);
+
+        return settings;
+    }
+
+    auto SpawnCars(const Settings &settings, const std::size_t existing) -> std::vector<std::shared_ptr<BumperCar> > {
+        std::vector<std::shared_ptr<BumperCar> > cars;
+
+        if (settings.cars <= existing) {
+            return cars;
+        }
+
+        cars.reserve(settings.cars - existing);
+
+        for (std::size_t i = existing; i < settings.cars; i++) {
+            const auto car = std::make_shared<BumperCar>(Random::Vec2(-ARENA / 2.0F, ARENA / 2.0F),
+                                                         Random::Float(20.0F, ARENA / 2.0F));
+            car->setMode(MODES[i % MODES.size()]);
+
+            const auto position = glm::vec3(Random::Float(-ARENA, ARENA), 10.0F, Random::Float(-ARENA, ARENA));
+            glm::mat4 transform = translate(Config::IDENTITY_MATRIX, position);
+            transform = scale(transform, glm::vec3(4.0F));
+            car->transform(transform);
+            car->attributes.scale = glm::vec3(4.0F);
+
+            cars.push_back(car);
+        }
+
+        return cars;
+    }
+
+    void PlaceEmitters(const Settings &settings, const ProceduralTerrain &terrain, ECS::Registry &registry) {
+        const auto place = [&](const ECS::Emitter &emitter) {
+            const float x = Random::Float(-ARENA, ARENA);
+            const float z = Random::Float(-ARENA, ARENA);
+
+            const ECS::Id id = registry.create();
+            registry.add<ECS::Transform>(id, translate(Config::IDENTITY_MATRIX,
+                                                       glm::vec3(x, terrain.getTerrainHeight(x, z), z)));
+            registry.add<ECS::Emitter>(id, emitter);
+        };
+
+        for (std::size_t i = 0; i < settings.emitters; i++) {
+            place({glm::vec3(0.0F, 15.0F, 0.0F), Random::Vec3(0.2F, 1.0F)});
+        }
+
+        for (std::size_t i = 0; i < settings.fires; i++) {
+            place({glm::vec3(0.0F, 8.0F, 0.0F), Color::ORANGE, 5, 1.0F, 2.0F, true});
+        }
+    }
+
+    Recorder::Recorder(Settings settings) : settings(std::move(settings)) {
+    }
+
+    auto Recorder::frame(const float frameTime, const Simulation::Timings &timings) -> bool {
+        elapsed += frameTime;
+
+        if (elapsed > settings.warmUp) {
+            frames.push_back(frameTime * 1000.0F);
+            players.push_back(timings.players - previous.players);
+            particles.push_back(timings.particles - previous.particles);
+            cars.push_back(timings.cars - previous.cars);
+            terrain.push_back(timings.terrain - previous.terrain);
+            entities.push_back(timings.entities - previous.entities);
+        }
+
+        previous = timings;
+
+        return elapsed >= settings.warmUp + settings.duration;
+    }
+
+    void Recorder::report() const {
+        const std::array<std::pair<std::string_view, Summary>, 6> rows = {
+            {
+                {"Frame", Summarise(frames)},
+                {"Player collisions", Summarise(players)},
+                {"Particles", Summarise(particles)},
+                {"Car collisions", Summarise(cars)},
+                {"Terrain and wall collisions", Summarise(terrain)},
+                {"Entities", Summarise(entities)},
+            }
+        };
+
+        std::println("Stress run: {} cars, {} emitters, {} fires, {} trees, {} clouds, {}x{} chunks, {} frames over "
+                     "{:.1f} s", settings.cars, settings.emitters, settings.fires, settings.trees, settings.clouds,
+                     settings.chunks, settings.chunks, frames.size(), settings.duration);
+        std::println("{:<28}{:>10}{:>10}{:>10}{:>10}", "Phase (ms)", "p50", "p90", "p99", "max");
+
+        for (const auto &[name, summary]: rows) {
+            std::println("{:<28}{:>10.3f}{:>10.3f}{:>10.3f}{:>10.3f}", name, summary.percentiles[0],
+                         summary.percentiles[1], summary.percentiles[2], summary.max);
+        }
+
+        if (settings.log.empty()) {
+            return;
+        }
+
+        const bool header = !std::filesystem::exists(settings.log);
+        std::ofstream file(settings.log, std::ios::app);
+
+        if (!file) {
+            std::println(stderr, "Failed to open {}", settings.log.string());
+            return;
+        }
+
+        if (header) {
+            std::print(file, "cars,emitters,fires,trees,clouds,chunks,frames");
+            for (const auto &[name, summary]: rows) {
+                std::print(file, ",{0} p50,{0} p90,{0} p99,{0} max", name);
+            }
+            std::println(file, "");
+        }
+
+        std::print(file, "{},{},{},{},{},{},{}", settings.cars, settings.emitters, settings.fires, settings.trees,
+                   settings.clouds, settings.chunks, frames.size());
+        for (const auto &[name, summary]: rows) {
+            std::print(file, ",{:.4f},{:.4f},{:.4f},{:.4f}", summary.percentiles[0], summary.percentiles[1],
+                       summary.percentiles[2], summary.max);
+        }
+        std::println(file, "");
+    }
+}
@@ -0,0 +1,78 @@
+//
+// Created by Jacob Edwards on 22/05/2024.
+//
+
+#ifndef CW_STRESSTEST_H
+#define CW_STRESSTEST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Simulation.h"
+#include "ecs/Registry.h"
+#include "renderables/objects/BumperCar.h"
+#include "renderables/objects/ProceduralTerrain.h"
+
+// the normal scene with every count turned up from the command line, run for a fixed time and reporting
+// frame time percentiles, so each subsystem can be charted as its count goes up by orders of magnitude
+namespace StressTest {
+    struct Settings {
+        // total, including the ones the normal scene makes
+        std::size_t cars = 11;
+        std::size_t emitters = 0;
+        std::size_t fires = 0;
+        int trees = NUM_TREE_INSTANCES;
+        int clouds = NUM_CLOUD_INSTANCES;
+        // terrain chunks along each side
+        int chunks = DEFAULT_NUM_CHUNKS_X;
+        // seconds measured, after the warm up
+        float duration = 30.0F;
+        float warmUp = 2.0F;
+        std::uint32_t seed = 1;
+        // one csv row per run is appended here, empty to skip
+        std::filesystem::path log;
+    };
+
+    // --stress [--cars n] [--emitters n] [--fires n] [--trees n] [--clouds n] [--chunks n] [--duration s]
+    // [--warmup s] [--seed n] [--log path], nothing when --stress isn't there
+    [[nodiscard]] auto ParseArguments(std::span<char *const> arguments) -> std::optional<Settings>;
+
+    // the cars beyond the ones already made, cycling through the ai modes and spread inside the walls
+    [[nodiscard]] auto SpawnCars(const Settings &settings, std::size_t existing) -> std::vector<std::shared_ptr<
+        BumperCar> >;
+
+    // fixed spots on the ground that spray particles every tick, the fires glow as well. ECS::Systems::Emit
+    // and Lights drive them from there
+    void PlaceEmitters(const Settings &settings, const ProceduralTerrain &terrain, ECS::Registry &registry);
+
+    // collects a sample per frame and reports once the run is over
+    class Recorder {
+    public:
+        explicit Recorder(Settings settings);
+
+        // true once the run has gone on long enough, the caller should stop and report
+        auto frame(float frameTime, const Simulation::Timings &timings) -> bool;
+
+        void report() const;
+
+    private:
+        Settings settings;
+        float elapsed = 0.0F;
+        Simulation::Timings previous;
+
+        // milliseconds per frame, the whole frame first and then each simulation phase
+        std::vector<float> frames;
+        std::vector<float> players;
+        std::vector<float> particles;
+        std::vector<float> cars;
+        std::vector<float> terrain;
+        std::vector<float> entities;
+    };
+}
+
+#endif //CW_STRESSTEST_H
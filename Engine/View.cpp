@@ -14,10 +14,13 @@
 #include <string>
 #include <utility>
 
+#include "graphics/GpuProfiler.h"
 #include "graphics/PostProcessor.h"
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw.h"
 #include "imgui/imgui_impl_opengl3.h"
+#include "utils/Allocations.h"
+#include "utils/Profiler.h"
 
 auto setupGLEW() -> bool {
     glewExperimental = GL_TRUE;
@@ -111,6 +114,9 @@ auto View::init(const std::string &title, const int width, const int height) ->
 }
 
 void View::quit() const {
+    // gl objects owned by singletons have to go before the context does
+    GpuProfiler::GetInstance().shutdown();
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -192,23 +198,37 @@ void View::clearTarget(const glm::vec3 &color, const bool clearc,
 }
 
 void View::render() {
+    PROFILE_ZONE("Render");
+    ALLOCATION_SCOPE(RENDERING);
+
+    // timings from a few frames back that have come in since
+    GpuProfiler::GetInstance().frame();
+
     const auto currentFrame = static_cast<float>(glfwGetTime());
-    deltaTime = currentFrame - lastFrame;
+    frameTime = currentFrame - lastFrame;
+    deltaTime = (clock)(frameTime);
     lastFrame = currentFrame;
+    time += deltaTime;
 
     keyLoop();
 
     if (postProcessorEnabled) {
         postProcessor->begin();
-        (pipeline)();
+        {
+            PROFILE_ZONE("Pipeline");
+            (pipeline)();
+        }
         postProcessor->end();
 
+        PROFILE_GPU("Post process");
         postProcessor->render(deltaTime);
     } else {
+        PROFILE_ZONE("Pipeline");
         (pipeline)();
     }
 
     if (showInterface) {
+        PROFILE_GPU("Interface");
         interfaceLoop();
     }
 }
@@ -235,6 +255,8 @@ void View::setResize(Handle handle) { resize = std::move(handle); }
 
 void View::setError(ErrorHandle handle) { error = std::move(handle); }
 
+void View::setClock(ClockHandle handle) { clock = std::move(handle); }
+
 void View::close() const { glfwSetWindowShouldClose(window, GLFW_TRUE); }
 
 auto View::getKey(const int key) const -> int { return glfwGetKey(window, key); }
@@ -25,6 +25,8 @@
 class View {
     using Handle = std::function<void()>;
     using ErrorHandle = std::function<void(int, const char *)>;
+    // takes the measured frame time and returns the one the frame runs with
+    using ClockHandle = std::function<float(float)>;
 
 public:
     View() = default;
@@ -51,6 +53,8 @@ public:
 
     void setError(ErrorHandle handle);
 
+    void setClock(ClockHandle handle);
+
     static void clearTarget(const glm::vec3 &color = Color::BLACK,
                             bool clearc = true, bool cleard = true);
 
@@ -86,6 +90,9 @@ public:
 
     [[nodiscard]] auto getDeltaTime() const -> float { return deltaTime; }
 
+    // what the last frame really took, the same as getDeltaTime unless the clock handle replaced it
+    [[nodiscard]] auto getFrameTime() const -> float { return frameTime; }
+
     [[nodiscard]] auto isSetup() const -> bool { return setup; }
 
     [[nodiscard]] auto getWindow() const -> GLFWwindow * { return window; }
@@ -105,11 +112,16 @@ public:
     void optionsInterface();
 
     void blurScreen() const {
+        if (postProcessor == nullptr) {
+            return;
+        }
+
         postProcessor->isBlurred();
     }
 
+    // the delta times summed, so it follows the clock handle rather than the wall clock
     [[nodiscard]] auto getTime() const -> float {
-        return lastFrame;
+        return time;
     }
 
     bool highQuality = false;
@@ -168,6 +180,10 @@ private:
         std::println(stderr, "Error: {} - {}", err, description);
     };
 
+    ClockHandle clock = [](const float measured) {
+        return measured;
+    };
+
     bool setup = false;
 
     // mouse
@@ -185,7 +201,9 @@ private:
 
     // time
     float deltaTime = 0.0F;
+    float frameTime = 0.0F;
     float lastFrame = 0.0F;
+    float time = 0.0F;
 
     bool wireframe = false;
 };
@@ -0,0 +1,33 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#include "Adapter.h"
+
+#include <cstddef>
+
+#include "ecs/Components.h"
+
+namespace ECS::Adapter {
+    auto Link(Registry &registry, Entity &entity) -> Id {
+        const Id id = registry.create();
+
+        registry.add<Linked>(id, &entity);
+        registry.add<Collider>(id);
+
+        return id;
+    }
+
+    void Pull(Registry &registry) {
+        auto &colliders = registry.pool<Collider>();
+
+        auto &linked = registry.pool<Linked>();
+        const auto ids = linked.getIds();
+        const auto entities = linked.getComponents();
+
+        for (std::size_t i = 0; i < ids.size(); i++) {
+            const auto [min, max] = entities[i].entity->getBoundingBox().getMinMax();
+            colliders.get(ids[i]) = {min, max};
+        }
+    }
+}
@@ -0,0 +1,23 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_ADAPTER_H
+#define CW_ADAPTER_H
+
+#include "ecs/Registry.h"
+#include "renderables/Entity.h"
+
+// lets the existing Entity classes use the registry as a collision broadphase without being rewritten. only
+// the box is mirrored, movement, steering and collision response stay in the entity's own virtual update.
+// the entity has to outlive the registry, it is only pointed at
+namespace ECS::Adapter {
+    // gives the entity a collider and a link back to itself
+    auto Link(Registry &registry, Entity &entity) -> Id;
+
+    // copies every linked entity's box into its collider, once per tick before the pair test. this is the
+    // one pass that touches the entities, the pair loop after it only reads packed colliders
+    void Pull(Registry &registry);
+}
+
+#endif //CW_ADAPTER_H
@@ -0,0 +1,52 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_COMPONENTS_H
+#define CW_COMPONENTS_H
+
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float3.hpp>
+
+#include "Config.h"
+#include "graphics/Color.h"
+
+class Entity;
+
+// plain data only, the behaviour lives in the systems
+namespace ECS {
+    struct Transform {
+        glm::mat4 model = Config::IDENTITY_MATRIX;
+
+        [[nodiscard]] auto getPosition() const -> glm::vec3 { return glm::vec3(model[3]); }
+    };
+
+    // world space box, the same test as BoundingBox without the gl buffer and children that come with it
+    struct Collider {
+        glm::vec3 min = glm::vec3(0.0F);
+        glm::vec3 max = glm::vec3(0.0F);
+
+        [[nodiscard]] auto overlaps(const Collider &other) const -> bool {
+            return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+    };
+
+    // sprays particles from the entity's position every tick, lights ones that glow
+    struct Emitter {
+        glm::vec3 velocity = glm::vec3(0.0F, 15.0F, 0.0F);
+        glm::vec3 color = Color::WHITE;
+        int count = 10;
+        float life = 1.0F;
+        float scale = 1.0F;
+        bool light = false;
+    };
+
+    // an existing Entity mirrored into the registry for the broadphase, it keeps its own behaviour and
+    // attributes and the adapter copies its box in each tick
+    struct Linked {
+        Entity *entity = nullptr;
+    };
+}
+
+#endif //CW_COMPONENTS_H
@@ -0,0 +1,219 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+/*
+ * https://skypjack.github.io/2019-03-07-ecs-baf-part-2/
+ */
+
+#ifndef CW_REGISTRY_H
+#define CW_REGISTRY_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+// sparse set storage, one pool per component type. every pool keeps its components packed in a dense
+// array, so a system walking one pool reads memory front to back with no pointers to follow. it holds the
+// stress test's emitters and the cars' colliders for the broadphase, the cars themselves aren't in it
+namespace ECS {
+    using Id = std::uint32_t;
+
+    constexpr Id NONE = std::numeric_limits<Id>::max();
+
+    class PoolBase {
+    public:
+        PoolBase() = default;
+
+        virtual ~PoolBase() = default;
+
+        PoolBase(const PoolBase &) = delete;
+
+        auto operator=(const PoolBase &) -> PoolBase & = delete;
+
+        [[nodiscard]] auto contains(const Id id) const -> bool {
+            return id < sparse.size() && sparse[id] != NONE;
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t { return ids.size(); }
+
+        // the entity owning each dense slot, in the same order as the components
+        [[nodiscard]] auto getIds() const -> std::span<const Id> { return ids; }
+
+        virtual void remove(Id id) = 0;
+
+    protected:
+        std::vector<Id> sparse;
+        std::vector<Id> ids;
+    };
+
+    template<typename T>
+    class Pool final : public PoolBase {
+    public:
+        template<typename... Args>
+        auto add(const Id id, Args &&... args) -> T & {
+            if (contains(id)) {
+                return components[sparse[id]] = T(std::forward<Args>(args)...);
+            }
+
+            if (id >= sparse.size()) {
+                sparse.resize(id + 1, NONE);
+            }
+
+            sparse[id] = static_cast<Id>(ids.size());
+            ids.push_back(id);
+
+            return components.emplace_back(std::forward<Args>(args)...);
+        }
+
+        // swaps the last component into the hole, so the dense array never has gaps
+        void remove(const Id id) override {
+            if (!contains(id)) {
+                return;
+            }
+
+            const Id slot = sparse[id];
+            const Id last = ids.back();
+
+            components[slot] = std::move(components.back());
+            ids[slot] = last;
+            sparse[last] = slot;
+
+            components.pop_back();
+            ids.pop_back();
+            sparse[id] = NONE;
+        }
+
+        [[nodiscard]] auto get(const Id id) -> T & {
+            assert(contains(id));
+            return components[sparse[id]];
+        }
+
+        [[nodiscard]] auto get(const Id id) const -> const T & {
+            assert(contains(id));
+            return components[sparse[id]];
+        }
+
+        [[nodiscard]] auto find(const Id id) -> T * {
+            return contains(id) ? &components[sparse[id]] : nullptr;
+        }
+
+        [[nodiscard]] auto getComponents() -> std::span<T> { return components; }
+
+        [[nodiscard]] auto getComponents() const -> std::span<const T> { return components; }
+
+    private:
+        std::vector<T> components;
+    };
+
+    class Registry {
+    public:
+        Registry() = default;
+
+        auto create() -> Id {
+            if (!free.empty()) {
+                const Id id = free.back();
+                free.pop_back();
+                return id;
+            }
+
+            return next++;
+        }
+
+        void destroy(const Id id) {
+            for (const auto &pool: pools) {
+                if (pool != nullptr) {
+                    pool->remove(id);
+                }
+            }
+
+            free.push_back(id);
+        }
+
+        template<typename T, typename... Args>
+        auto add(const Id id, Args &&... args) -> T & {
+            return pool<T>().add(id, std::forward<Args>(args)...);
+        }
+
+        template<typename T>
+        void remove(const Id id) {
+            pool<T>().remove(id);
+        }
+
+        template<typename T>
+        [[nodiscard]] auto has(const Id id) const -> bool {
+            const auto *existing = find<T>();
+            return existing != nullptr && existing->contains(id);
+        }
+
+        template<typename T>
+        [[nodiscard]] auto get(const Id id) -> T & {
+            return pool<T>().get(id);
+        }
+
+        template<typename T>
+        [[nodiscard]] auto pool() -> Pool<T> & {
+            const std::size_t index = Index<T>();
+
+            if (index >= pools.size()) {
+                pools.resize(index + 1);
+            }
+
+            if (pools[index] == nullptr) {
+                pools[index] = std::make_unique<Pool<T> >();
+            }
+
+            return static_cast<Pool<T> &>(*pools[index]);
+        }
+
+        // walks the first component's pool in dense order and skips anything missing one of the others, so
+        // put the rarest component first
+        template<typename T, typename... Others, typename F>
+        void each(F &&function) {
+            auto &first = pool<T>();
+
+            [&](Pool<Others> &... others) {
+                const auto ids = first.getIds();
+                const auto components = first.getComponents();
+
+                for (std::size_t i = 0; i < ids.size(); i++) {
+                    if ((others.contains(ids[i]) && ...)) {
+                        function(ids[i], components[i], others.get(ids[i])...);
+                    }
+                }
+            }(pool<Others>()...);
+        }
+
+        // how many ids have been handed out, destroyed ones included
+        [[nodiscard]] auto capacity() const -> std::size_t { return next; }
+
+    private:
+        std::vector<std::unique_ptr<PoolBase> > pools;
+        std::vector<Id> free;
+        Id next = 0;
+
+        template<typename T>
+        [[nodiscard]] auto find() const -> const Pool<T> * {
+            const std::size_t index = Index<T>();
+            return index < pools.size() ? static_cast<const Pool<T> *>(pools[index].get()) : nullptr;
+        }
+
+        static auto Counter() -> std::size_t {
+            static std::size_t counter = 0;
+            return counter++;
+        }
+
+        // a small number per component type, handed out the first time each type is used
+        template<typename T>
+        static auto Index() -> std::size_t {
+            static const std::size_t index = Counter();
+            return index;
+        }
+    };
+}
+
+#endif //CW_REGISTRY_H
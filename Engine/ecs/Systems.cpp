@@ -0,0 +1,44 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#include "Systems.h"
+
+#include <memory_resource>
+#include <vector>
+
+#include <glm/ext/vector_float3.hpp>
+
+#include "ecs/Components.h"
+#include "renderables/Particle.h"
+
+namespace ECS::Systems {
+    void Emit(Registry &registry) {
+        ParticleSystem &particleSystem = ParticleSystem::GetInstance();
+
+        registry.each<Emitter, Transform>([&](Id, const Emitter &emitter, const Transform &transform) {
+            particleSystem.generate(transform.getPosition(), emitter.velocity, emitter.color, emitter.count,
+                                    emitter.life, emitter.scale);
+        });
+    }
+
+    void Lights(Registry &registry, std::pmr::vector<PointLight> &lights) {
+        registry.each<Emitter, Transform>([&](Id, const Emitter &emitter, const Transform &transform) {
+            if (!emitter.light) {
+                return;
+            }
+
+            // the same falloff as a half wrecked car
+            PointLight light{};
+            light.position = transform.getPosition() + glm::vec3(0.0F, 2.5F, 0.0F);
+            light.ambient = emitter.color;
+            light.diffuse = emitter.color;
+            light.specular = emitter.color;
+            light.constant = 0.9F;
+            light.linear = 0.115F;
+            light.quadratic = 0.042F;
+
+            lights.push_back(light);
+        });
+    }
+}
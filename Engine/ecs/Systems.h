@@ -0,0 +1,24 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_SYSTEMS_H
+#define CW_SYSTEMS_H
+
+#include <memory_resource>
+#include <vector>
+
+#include "ecs/Registry.h"
+#include "utils/Lights.h"
+
+// each system walks one pool in dense order, looking the rest up by id. only the stress test's emitters
+// live in the registry outright, the cars are linked in for their colliders and still update themselves,
+// the car pass in Simulation::Step is their only use of it
+namespace ECS::Systems {
+    void Emit(Registry &registry);
+
+    // a point light above every emitter that glows
+    void Lights(Registry &registry, std::pmr::vector<PointLight> &lights);
+}
+
+#endif //CW_SYSTEMS_H
@@ -0,0 +1,218 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#include "GpuMemory.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <print>
+#include <ranges>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "imgui/imgui.h"
+
+namespace GpuMemory {
+    namespace {
+        constexpr auto CATEGORIES = static_cast<std::size_t>(Category::COUNT);
+
+        constexpr std::array<const char *, CATEGORIES> NAMES = {
+            "Geometry", "Shader data", "Textures", "Render targets", "Shadows"
+        };
+
+        constexpr float MEGABYTE = 1024.0F * 1024.0F;
+
+        struct Allocation {
+            Category category = Category::GEOMETRY;
+            std::size_t bytes = 0;
+            std::string_view owner;
+        };
+
+        struct State {
+            std::map<std::pair<Object, GLuint>, Allocation> allocations;
+            std::array<std::size_t, CATEGORIES> categories{};
+            std::size_t total = 0;
+            std::size_t peak = 0;
+            std::size_t budget = Config::GPU_MEMORY_BUDGET;
+            // so release builds only complain once each time it goes over
+            bool over = false;
+        };
+
+        // never destroyed, static objects still release into it on the way out
+        auto Get() -> State & {
+            static auto *state = new State();
+            return *state;
+        }
+
+        void Remove(State &state, const Allocation &allocation) {
+            state.categories[static_cast<std::size_t>(allocation.category)] -= allocation.bytes;
+            state.total -= allocation.bytes;
+        }
+
+        void Check(State &state) {
+            if (state.total <= state.budget) {
+                state.over = false;
+                return;
+            }
+
+            if (!state.over) {
+                std::println(stderr, "GPU memory over budget: {:.1f} MB of {:.1f} MB",
+                             static_cast<float>(state.total) / MEGABYTE, static_cast<float>(state.budget) / MEGABYTE);
+                state.over = true;
+            }
+        }
+    }
+
+    void Track(const Object object, const GLuint id, const Category category, const std::size_t bytes,
+               const std::string_view owner) {
+        if (id == 0U) {
+            return;
+        }
+
+        auto &state = Get();
+        auto &allocation = state.allocations[{object, id}];
+
+        Remove(state, allocation);
+        allocation = {category, bytes, owner};
+
+        state.categories[static_cast<std::size_t>(category)] += bytes;
+        state.total += bytes;
+        state.peak = std::max(state.peak, state.total);
+
+        Check(state);
+        assert(state.total <= state.budget && "GPU memory over budget, see the GPU Memory panel");
+    }
+
+    void Release(const Object object, const GLuint id) {
+        auto &state = Get();
+
+        if (const auto it = state.allocations.find({object, id}); it != state.allocations.end()) {
+            Remove(state, it->second);
+            state.allocations.erase(it);
+        }
+    }
+
+    auto ImageBytes(const GLenum format, const GLsizei width, const GLsizei height, const GLsizei depth,
+                    const GLsizei samples) -> std::size_t {
+        std::size_t texel = 4;
+
+        switch (format) {
+            case GL_RED:
+            case GL_R8:
+                texel = 1;
+                break;
+            case GL_RG:
+            case GL_RG8:
+                texel = 2;
+                break;
+            case GL_RGBA16F:
+            case GL_RGB16F:
+                texel = 8;
+                break;
+            case GL_RGBA32F:
+                texel = 16;
+                break;
+            default:
+                // rgba8 and the depth formats, three channel formats are padded out to four too
+                break;
+        }
+
+        return texel * static_cast<std::size_t>(width) * static_cast<std::size_t>(height) *
+               static_cast<std::size_t>(depth) * static_cast<std::size_t>(samples);
+    }
+
+    auto Total() -> std::size_t {
+        return Get().total;
+    }
+
+    auto Total(const Category category) -> std::size_t {
+        return Get().categories[static_cast<std::size_t>(category)];
+    }
+
+    void SetBudget(const std::size_t bytes) {
+        auto &state = Get();
+        state.budget = bytes;
+        Check(state);
+    }
+
+    void Interface() {
+        auto &state = Get();
+
+        ImGui::Begin("GPU Memory");
+
+        const float fraction = static_cast<float>(state.total) / static_cast<float>(std::max<std::size_t>(
+                                   state.budget, 1));
+        ImGui::ProgressBar(std::min(fraction, 1.0F), ImVec2(-1.0F, 0.0F), nullptr);
+        ImGui::Text("%.1f MB of %.1f MB, peak %.1f MB, %zu objects", static_cast<float>(state.total) / MEGABYTE,
+                    static_cast<float>(state.budget) / MEGABYTE, static_cast<float>(state.peak) / MEGABYTE,
+                    state.allocations.size());
+
+        // typed values only land on enter, a half typed number would otherwise become the budget
+        int budget = static_cast<int>(state.budget / (1024U * 1024U));
+        if (ImGui::InputInt("Budget (MB)", &budget, 64, 256, ImGuiInputTextFlags_EnterReturnsTrue)) {
+            SetBudget(static_cast<std::size_t>(std::max(budget, 1)) * 1024U * 1024U);
+        }
+
+        if (ImGui::BeginTable("Categories", 2)) {
+            ImGui::TableSetupColumn("Category");
+            ImGui::TableSetupColumn("MB");
+            ImGui::TableHeadersRow();
+
+            for (std::size_t i = 0; i < CATEGORIES; i++) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(NAMES[i]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<float>(state.categories[i]) / MEGABYTE);
+            }
+
+            ImGui::EndTable();
+        }
+
+        struct Owner {
+            std::size_t bytes = 0;
+            std::size_t objects = 0;
+        };
+
+        std::map<std::string_view, Owner> owners;
+        for (const auto &allocation: state.allocations | std::views::values) {
+            auto &[bytes, objects] = owners[allocation.owner];
+            bytes += allocation.bytes;
+            objects++;
+        }
+
+        std::vector<std::pair<std::string_view, Owner> > sorted(owners.begin(), owners.end());
+        std::ranges::sort(sorted, [](const auto &a, const auto &b) {
+            return a.second.bytes > b.second.bytes;
+        });
+
+        if (ImGui::BeginTable("Owners", 3)) {
+            ImGui::TableSetupColumn("Owner");
+            ImGui::TableSetupColumn("MB");
+            ImGui::TableSetupColumn("Objects");
+            ImGui::TableHeadersRow();
+
+            for (const auto &[owner, total]: sorted) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(owner.data(), owner.data() + owner.size());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<float>(total.bytes) / MEGABYTE);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", total.objects);
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+}
@@ -0,0 +1,56 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_GPUMEMORY_H
+#define CW_GPUMEMORY_H
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// what every buffer, texture and render target asked the driver for, by category and by owner. these
+// are the sizes requested, the driver is free to pad them or keep extra copies, so treat the totals as a
+// floor. gl thread only, like the objects being counted
+namespace GpuMemory {
+    enum class Category : std::uint8_t {
+        GEOMETRY,
+        // uniform and texture buffers the shaders read
+        SHADER_DATA,
+        TEXTURES,
+        RENDER_TARGETS,
+        SHADOWS,
+        COUNT,
+    };
+
+    // gl names are only unique within one kind of object
+    enum class Object : std::uint8_t {
+        BUFFER,
+        TEXTURE,
+        RENDERBUFFER,
+    };
+
+    // records an allocation, or replaces it when the object is given new storage. the owner is what the
+    // panel groups by and has to outlive the allocation, a string literal in practice. name 0 is ignored,
+    // so headless objects that never made one can call this as they are
+    void Track(Object object, GLuint id, Category category, std::size_t bytes, std::string_view owner);
+
+    void Release(Object object, GLuint id);
+
+    // bytes for an uncompressed image of the internal format, mips not included
+    [[nodiscard]] auto ImageBytes(GLenum format, GLsizei width, GLsizei height, GLsizei depth = 1,
+                                  GLsizei samples = 1) -> std::size_t;
+
+    [[nodiscard]] auto Total() -> std::size_t;
+
+    [[nodiscard]] auto Total(Category category) -> std::size_t;
+
+    // an allocation going over it asserts, and prints once in release builds. lowering it below what's in use
+    // only prints
+    void SetBudget(std::size_t bytes);
+
+    void Interface();
+}
+
+#endif //CW_GPUMEMORY_H
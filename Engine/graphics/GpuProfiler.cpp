@@ -0,0 +1,162 @@
+//
+// Created by Jacob Edwards on 20/05/2024.
+//
+
+#include "GpuProfiler.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <string_view>
+
+#include "imgui/imgui.h"
+
+GpuProfiler::Scope::Scope(const std::string_view name) : pass(GetInstance().begin(name, timing)),
+                                                          start(std::chrono::high_resolution_clock::now()) {
+}
+
+GpuProfiler::Scope::~Scope() {
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    if (timing) {
+        GetInstance().end();
+    }
+
+    pass->cpu.push(std::chrono::duration<float, std::milli>(end - start).count());
+}
+
+void GpuProfiler::shutdown() {
+    for (auto &[name, pass]: passes) {
+        glDeleteQueries(static_cast<GLsizei>(LATENCY), pass.queries.data());
+    }
+
+    passes.clear();
+    active = nullptr;
+}
+
+void GpuProfiler::frame() {
+    for (auto &[name, pass]: passes) {
+        for (std::size_t slot = 0; slot < LATENCY; slot++) {
+            if (!pass.pending[slot]) {
+                continue;
+            }
+
+            GLint available = GL_FALSE;
+            glGetQueryObjectiv(pass.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+
+            if (available == GL_TRUE) {
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(pass.queries[slot], GL_QUERY_RESULT, &elapsed);
+
+                pass.gpu.push(static_cast<float>(elapsed) / 1.0e6F);
+                pass.pending[slot] = false;
+            }
+        }
+    }
+
+    frameIndex++;
+}
+
+auto GpuProfiler::getGpuStats(const std::string_view name) const -> Stats {
+    const auto it = passes.find(name);
+    return it != passes.end() ? it->second.gpu.stats() : Stats{};
+}
+
+auto GpuProfiler::getCpuStats(const std::string_view name) const -> Stats {
+    const auto it = passes.find(name);
+    return it != passes.end() ? it->second.cpu.stats() : Stats{};
+}
+
+void GpuProfiler::interface() const {
+    // shares the cpu profiler's window so the two sets of timings sit together
+    ImGui::Begin("Profiler");
+    ImGui::SeparatorText("Render passes (ms)");
+
+    if (ImGui::BeginTable("Passes", 6)) {
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("CPU");
+        ImGui::TableSetupColumn("GPU min");
+        ImGui::TableSetupColumn("GPU avg");
+        ImGui::TableSetupColumn("GPU max");
+        ImGui::TableSetupColumn("Skipped");
+        ImGui::TableHeadersRow();
+
+        for (const auto &[name, pass]: passes) {
+            const auto [min, average, max] = pass.gpu.stats();
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name.data(), name.data() + name.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.cpu.stats().average);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", min);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", average);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", max);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", pass.skipped);
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+void GpuProfiler::History::push(const float sample) {
+    samples[count % HISTORY] = sample;
+    count++;
+}
+
+auto GpuProfiler::History::stats() const -> Stats {
+    const std::size_t size = std::min(count, HISTORY);
+    if (size == 0) {
+        return {};
+    }
+
+    const auto first = samples.begin();
+    const auto last = samples.begin() + static_cast<std::ptrdiff_t>(size);
+    const auto [min, max] = std::minmax_element(first, last);
+
+    return {*min, std::accumulate(first, last, 0.0F) / static_cast<float>(size), *max};
+}
+
+auto GpuProfiler::begin(const std::string_view name, bool &timing) -> Pass * {
+    auto [it, inserted] = passes.try_emplace(name);
+    Pass &pass = it->second;
+
+    if (inserted) {
+        glGenQueries(static_cast<GLsizei>(LATENCY), pass.queries.data());
+    }
+
+    timing = false;
+
+    if (active != nullptr) {
+        return &pass;
+    }
+
+    const std::size_t slot = frameIndex % LATENCY;
+
+    // the last query in this slot is still in flight, skip a sample rather than wait on it
+    if (pass.pending[slot]) {
+        pass.skipped++;
+        return &pass;
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, pass.queries[slot]);
+    pass.pending[slot] = true;
+    active = &pass;
+    timing = true;
+
+    return &pass;
+}
+
+void GpuProfiler::end() {
+    glEndQuery(GL_TIME_ELAPSED);
+    active = nullptr;
+}
@@ -0,0 +1,109 @@
+//
+// Created by Jacob Edwards on 20/05/2024.
+//
+/*
+ * https://www.khronos.org/opengl/wiki/Query_Object#Timer_queries
+ */
+
+#ifndef CW_GPUPROFILER_H
+#define CW_GPUPROFILER_H
+
+#include <GL/glew.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string_view>
+
+#include "utils/Profiler.h"
+#include "utils/Singleton.h"
+
+// gpu time per render pass from GL_TIME_ELAPSED queries. each pass has a query per frame in flight and
+// results are only collected once the driver says they're available, so reading them never stalls.
+// elapsed queries can't nest, so passes have to be siblings, a pass started inside another isn't timed
+class GpuProfiler final : public Singleton<GpuProfiler> {
+    struct Pass;
+
+public:
+    // frames a query can be in flight before its slot comes round again
+    static constexpr std::size_t LATENCY = 3;
+    // samples the rolling min, average and max are taken over
+    static constexpr std::size_t HISTORY = 120;
+
+    // times the gpu work issued in its lifetime, and the cpu time spent issuing it
+    class Scope {
+    public:
+        explicit Scope(std::string_view name);
+
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+
+        auto operator=(const Scope &) -> Scope & = delete;
+
+    private:
+        bool timing = false;
+        Pass *pass;
+        std::chrono::high_resolution_clock::time_point start;
+    };
+
+    struct Stats {
+        float min = 0.0F;
+        float average = 0.0F;
+        float max = 0.0F;
+    };
+
+    explicit GpuProfiler(Token) {
+    }
+
+    // deletes every query while the context is still current. the singleton itself outlives the window,
+    // so this can't wait for the destructor
+    void shutdown();
+
+    // collects whatever finished since last frame and moves on to the next set of queries
+    void frame();
+
+    [[nodiscard]] auto getGpuStats(std::string_view name) const -> Stats;
+
+    [[nodiscard]] auto getCpuStats(std::string_view name) const -> Stats;
+
+    void interface() const;
+
+private:
+    struct History {
+        std::array<float, HISTORY> samples{};
+        std::size_t count = 0;
+
+        void push(float sample);
+
+        [[nodiscard]] auto stats() const -> Stats;
+    };
+
+    struct Pass {
+        std::array<GLuint, LATENCY> queries{};
+        std::array<bool, LATENCY> pending{};
+        History gpu;
+        History cpu;
+        // frames the slot's previous query still hadn't come back
+        std::size_t skipped = 0;
+    };
+
+    // keyed by the name's contents, so the same literal from two files is one pass
+    std::map<std::string_view, Pass> passes;
+    const Pass *active = nullptr;
+    std::size_t frameIndex = 0;
+
+    auto begin(std::string_view name, bool &timing) -> Pass *;
+
+    void end();
+};
+
+#ifdef CW_PROFILING
+#define PROFILE_GPU(name) \
+    PROFILE_ZONE(name); \
+    const GpuProfiler::Scope CW_PROFILE_CONCAT(gpuZone, __LINE__)(name)
+#else
+#define PROFILE_GPU(name) static_cast<void>(0)
+#endif
+
+#endif //CW_GPUPROFILER_H
@@ -0,0 +1,161 @@
+//
+// Created by Jacob Edwards on 15/05/2024.
+//
+
+#include "graphics/InstanceBatcher.h"
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <glm/ext/vector_float4.hpp>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "graphics/GpuMemory.h"
+#include "graphics/Model.h"
+#include "graphics/Shader.h"
+#include "imgui/imgui.h"
+
+InstanceBatcher::InstanceBatcher(Token) {
+    glGenBuffers(1, &instanceBuffer);
+}
+
+InstanceBatcher::~InstanceBatcher() {
+    GpuMemory::Release(GpuMemory::Object::BUFFER, instanceBuffer);
+    glDeleteBuffers(1, &instanceBuffer);
+}
+
+void InstanceBatcher::submit(const std::shared_ptr<Shader> &shader, const Model &model, const Instance &instance) {
+    submit(shader, model, std::span(&instance, 1));
+}
+
+void InstanceBatcher::submit(const std::shared_ptr<Shader> &shader, const Model &model,
+                             const std::span<const Instance> instances) {
+    for (const auto &mesh: model.getMeshes()) {
+        auto &batch = batches[{shader.get(), mesh.get()}];
+        batch.shader = shader;
+        batch.mesh = mesh.get();
+        batch.instances.insert(batch.instances.end(), instances.begin(), instances.end());
+    }
+
+    submitted += instances.size();
+}
+
+void InstanceBatcher::flush() {
+    // nothing came in for these since the last flush. the keys are raw pointers, so a mesh that has been
+    // freed must not keep its batch around for a new one to land on, and the batch's shader is let go too
+    std::erase_if(batches, [](const auto &entry) {
+        return entry.second.instances.empty();
+    });
+
+    if (batches.empty()) {
+        return;
+    }
+
+    // every batch goes into one buffer, each draw points the instance attributes at its own range
+    staging.clear();
+    for (const auto &[key, batch]: batches) {
+        staging.insert(staging.end(), batch.instances.begin(), batch.instances.end());
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    // orphan the old store so we never wait on the previous flush
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(staging.size() * sizeof(Instance)), nullptr,
+                 GL_STREAM_DRAW);
+    GpuMemory::Track(GpuMemory::Object::BUFFER, instanceBuffer, GpuMemory::Category::GEOMETRY,
+                     staging.size() * sizeof(Instance), "Instance batcher");
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(staging.size() * sizeof(Instance)),
+                    staging.data());
+
+    std::shared_ptr<Shader> current;
+    std::size_t offset = 0;
+
+    for (const auto &[key, batch]: batches) {
+        if (current != batch.shader) {
+            // still bound, so switch the previous program back to plain draws before leaving it
+            if (current != nullptr) {
+                current->setUniform("instanced", false);
+            }
+
+            current = batch.shader;
+            current->use();
+            current->setUniform("instanced", true);
+        }
+
+        batch.mesh->bindMaterial(batch.shader);
+
+        const auto &buffer = batch.mesh->getBuffer();
+        buffer.bind();
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        BindInstanceAttributes(offset * sizeof(Instance));
+
+        buffer.drawInstanced(batch.instances.size());
+
+        // the vao is shared with plain draws, which would otherwise read the stale instance range
+        UnbindInstanceAttributes();
+        buffer.unbind();
+
+        offset += batch.instances.size();
+        drawCalls++;
+    }
+
+    if (current != nullptr) {
+        current->setUniform("instanced", false);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    // keep the batches and their capacity for one more flush, most of the same models come back next frame
+    for (auto &[key, batch]: batches) {
+        batch.instances.clear();
+    }
+
+    flushes++;
+}
+
+void InstanceBatcher::interface() {
+    const auto perFlush = [this](const std::size_t total) {
+        return flushes == 0 ? 0.0F : static_cast<float>(total) / static_cast<float>(flushes);
+    };
+
+    ImGui::Begin("Instance Batcher");
+    ImGui::Text("Batches: %zu", batches.size());
+    ImGui::Text("Instances Per Flush: %.1f", perFlush(submitted));
+    ImGui::Text("Draw Calls Per Flush: %.1f", perFlush(drawCalls));
+    ImGui::Text("Instance Buffer: %.1f KB", static_cast<float>(staging.size() * sizeof(Instance)) / 1024.0F);
+    ImGui::End();
+
+    submitted = 0;
+    drawCalls = 0;
+    flushes = 0;
+}
+
+void InstanceBatcher::BindInstanceAttributes(const std::size_t offset) {
+    // a mat4 attribute takes four consecutive locations, one per column
+    for (GLuint i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(INSTANCE_MODEL_LOCATION + i);
+        glVertexAttribPointer(INSTANCE_MODEL_LOCATION + i, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                              reinterpret_cast<void *>(offset + offsetof(Instance, model) + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(INSTANCE_MODEL_LOCATION + i, 1);
+    }
+
+    glEnableVertexAttribArray(INSTANCE_COLOR_LOCATION);
+    glVertexAttribPointer(INSTANCE_COLOR_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<void *>(offset + offsetof(Instance, color)));
+    glVertexAttribDivisor(INSTANCE_COLOR_LOCATION, 1);
+
+    glEnableVertexAttribArray(INSTANCE_PARAMS_LOCATION);
+    glVertexAttribPointer(INSTANCE_PARAMS_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<void *>(offset + offsetof(Instance, params)));
+    glVertexAttribDivisor(INSTANCE_PARAMS_LOCATION, 1);
+}
+
+void InstanceBatcher::UnbindInstanceAttributes() {
+    for (GLuint i = 0; i < 4; i++) {
+        glDisableVertexAttribArray(INSTANCE_MODEL_LOCATION + i);
+    }
+
+    glDisableVertexAttribArray(INSTANCE_COLOR_LOCATION);
+    glDisableVertexAttribArray(INSTANCE_PARAMS_LOCATION);
+}
@@ -0,0 +1,80 @@
+//
+// Created by Jacob Edwards on 15/05/2024.
+//
+/*
+ * https://learnopengl.com/Advanced-OpenGL/Instancing
+ */
+
+#ifndef CW_INSTANCEBATCHER_H
+#define CW_INSTANCEBATCHER_H
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <map>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "graphics/Mesh.h"
+#include "graphics/Model.h"
+#include "graphics/Shader.h"
+#include "utils/Singleton.h"
+
+// attribute locations read by instancing.glsl, after the vertex attributes
+constexpr GLuint INSTANCE_MODEL_LOCATION = 6;
+constexpr GLuint INSTANCE_COLOR_LOCATION = 10;
+constexpr GLuint INSTANCE_PARAMS_LOCATION = 11;
+
+// uploaded as-is into the instance buffer, one per submitted model
+struct Instance {
+    glm::mat4 model = glm::mat4(1.0F);
+    glm::vec4 color = glm::vec4(1.0F);
+    // damage, time
+    glm::vec4 params = glm::vec4(0.0F);
+};
+
+// collects repeated model draws and issues one instanced draw per shader and mesh
+class InstanceBatcher final : public Singleton<InstanceBatcher> {
+public:
+    explicit InstanceBatcher(Token);
+
+    ~InstanceBatcher() override;
+
+    void submit(const std::shared_ptr<Shader> &shader, const Model &model, const Instance &instance);
+
+    void submit(const std::shared_ptr<Shader> &shader, const Model &model, std::span<const Instance> instances);
+
+    // draws everything submitted since the last flush
+    void flush();
+
+    void interface();
+
+private:
+    struct Batch {
+        std::shared_ptr<Shader> shader;
+        const Mesh *mesh = nullptr;
+        std::vector<Instance> instances;
+    };
+
+    // ordered by shader first so each program is only bound once per flush. a batch left empty through a
+    // whole flush is dropped at the start of the next one
+    std::map<std::pair<const Shader *, const Mesh *>, Batch> batches;
+
+    std::vector<Instance> staging;
+    GLuint instanceBuffer = 0;
+
+    // totals since the interface last read them
+    std::size_t submitted = 0;
+    std::size_t drawCalls = 0;
+    std::size_t flushes = 0;
+
+    static void BindInstanceAttributes(std::size_t offset);
+
+    static void UnbindInstanceAttributes();
+};
+
+
+#endif //CW_INSTANCEBATCHER_H
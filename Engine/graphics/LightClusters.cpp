@@ -0,0 +1,331 @@
+//
+// Created by Jacob Edwards on 14/05/2024.
+//
+
+#include "graphics/LightClusters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "graphics/GpuMemory.h"
+#include "imgui/imgui.h"
+#include "utils/Lights.h"
+#include "utils/Profiler.h"
+
+namespace {
+    // below this many visible lights waking the pool costs more than binning on the calling thread
+    constexpr std::size_t PARALLEL_LIGHTS = 64;
+}
+
+LightClusters::LightClusters() {
+    clusters.resize(CLUSTER_COUNT);
+    grid.resize(CLUSTER_COUNT);
+    sliceIndices.resize(CLUSTER_Z);
+
+    const unsigned int threads = std::clamp(std::thread::hardware_concurrency(), 1U, CLUSTER_Z);
+    slicesPerThread = (CLUSTER_Z + threads - 1) / threads;
+
+    // the first run of slices is left to the thread calling update
+    for (unsigned int first = slicesPerThread; first < CLUSTER_Z; first += slicesPerThread) {
+        const unsigned int last = std::min(first + slicesPerThread, CLUSTER_Z);
+        workers.emplace_back([this, first, last] {
+            work(first, last);
+        });
+    }
+
+    glGenBuffers(1, &lightBuffer);
+    glGenBuffers(1, &gridBuffer);
+    glGenBuffers(1, &indexBuffer);
+
+    Upload(lightBuffer, nullptr, 0);
+    Upload(gridBuffer, nullptr, 0);
+    Upload(indexBuffer, nullptr, 0);
+
+    glGenTextures(1, &lightTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, lightBuffer);
+
+    glGenTextures(1, &gridTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, gridTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, gridBuffer);
+
+    glGenTextures(1, &indexTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, indexBuffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+LightClusters::~LightClusters() {
+    {
+        const std::scoped_lock lock(poolMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    workers.clear();
+
+    GpuMemory::Release(GpuMemory::Object::BUFFER, lightBuffer);
+    GpuMemory::Release(GpuMemory::Object::BUFFER, gridBuffer);
+    GpuMemory::Release(GpuMemory::Object::BUFFER, indexBuffer);
+
+    glDeleteTextures(1, &lightTexture);
+    glDeleteTextures(1, &gridTexture);
+    glDeleteTextures(1, &indexTexture);
+
+    glDeleteBuffers(1, &lightBuffer);
+    glDeleteBuffers(1, &gridBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+}
+
+void LightClusters::update(const std::span<const PointLight> lights, const glm::mat4 &view,
+                           const glm::mat4 &projection, const float near, const float far, const float width,
+                           const float height) {
+    PROFILE_ZONE("Light clusters");
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    if (projection != clusterProjection || near != this->near || far != this->far) {
+        clusterProjection = projection;
+        this->near = near;
+        this->far = far;
+        buildClusters();
+    }
+
+    this->width = width;
+    this->height = height;
+
+    spheres.clear();
+    spheres.reserve(lights.size());
+
+    for (unsigned int i = 0; i < lights.size(); i++) {
+        const auto center = glm::vec3(view * glm::vec4(lights[i].position, 1.0F));
+        const float radius = Radius(lights[i]);
+
+        // behind the camera or past the far plane
+        if (-center.z + radius < near || -center.z - radius > far) {
+            continue;
+        }
+
+        spheres.push_back({center, radius, i});
+    }
+
+    if (workers.empty() || spheres.size() < PARALLEL_LIGHTS) {
+        binSlices(0, CLUSTER_Z);
+    } else {
+        {
+            const std::scoped_lock lock(poolMutex);
+            running = static_cast<unsigned int>(workers.size());
+            generation++;
+        }
+        wake.notify_all();
+
+        binSlices(0, slicesPerThread);
+
+        std::unique_lock lock(poolMutex);
+        finished.wait(lock, [this] { return running == 0; });
+    }
+
+    // stitch the per slice lists together and rebase the grid offsets
+    indices.clear();
+    maxClusterLights = 0;
+
+    for (unsigned int z = 0; z < CLUSTER_Z; z++) {
+        const auto offset = static_cast<GLuint>(indices.size());
+
+        for (unsigned int i = z * CLUSTER_X * CLUSTER_Y; i < (z + 1) * CLUSTER_X * CLUSTER_Y; i++) {
+            grid[i].x += offset;
+            maxClusterLights = std::max(maxClusterLights, grid[i].y);
+        }
+
+        indices.insert(indices.end(), sliceIndices[z].begin(), sliceIndices[z].end());
+    }
+
+    overflow = std::accumulate(sliceOverflow.begin(), sliceOverflow.end(), 0U);
+
+    lightCount = static_cast<unsigned int>(lights.size());
+
+    Upload(lightBuffer, lights.data(), static_cast<GLsizeiptr>(lights.size() * sizeof(PointLight)));
+    Upload(gridBuffer, grid.data(), static_cast<GLsizeiptr>(grid.size() * sizeof(glm::uvec2)));
+    Upload(indexBuffer, indices.data(), static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)));
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    binTime = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+void LightClusters::fill(Lights &lights) const {
+    // exponential depth slices, slice = log(z) * scale + bias
+    const float logRatio = std::log(far / near);
+    const float scale = static_cast<float>(CLUSTER_Z) / logRatio;
+    const float bias = -static_cast<float>(CLUSTER_Z) * std::log(near) / logRatio;
+
+    lights.clusterGrid = glm::uvec4(CLUSTER_X, CLUSTER_Y, CLUSTER_Z, lightCount);
+    lights.clusterDepth = glm::vec4(near, far, scale, bias);
+    lights.screenSize = glm::vec2(width, height);
+}
+
+void LightClusters::bind() const {
+    glActiveTexture(GL_TEXTURE0 + POINT_LIGHT_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+
+    glActiveTexture(GL_TEXTURE0 + CLUSTER_GRID_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, gridTexture);
+
+    glActiveTexture(GL_TEXTURE0 + CLUSTER_INDEX_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void LightClusters::interface() const {
+    ImGui::Begin("Light Clusters");
+    ImGui::Text("Point Lights: %u", lightCount);
+    ImGui::Text("Visible Lights: %zu", spheres.size());
+    ImGui::Text("Light Indices: %zu", indices.size());
+    ImGui::Text("Max Lights Per Cluster: %u / %u", maxClusterLights, MAX_LIGHTS_PER_CLUSTER);
+    if (overflow > 0) {
+        // these lights still light the clusters they fit in, they just go unlit in the full ones
+        ImGui::TextColored(ImVec4(1.0F, 0.4F, 0.4F, 1.0F), "Dropped: %u light entries from full clusters", overflow);
+    } else {
+        ImGui::Text("Dropped: 0");
+    }
+    ImGui::Text("Binning: %.3f ms", binTime);
+    ImGui::End();
+}
+
+void LightClusters::buildClusters() {
+    // view space ray through each tile edge at unit depth, assumes a symmetric perspective projection
+    const float xScale = 1.0F / clusterProjection[0][0];
+    const float yScale = 1.0F / clusterProjection[1][1];
+
+    for (unsigned int z = 0; z < CLUSTER_Z; z++) {
+        const float sliceNear = near * std::pow(far / near, static_cast<float>(z) / CLUSTER_Z);
+        const float sliceFar = near * std::pow(far / near, static_cast<float>(z + 1) / CLUSTER_Z);
+
+        for (unsigned int y = 0; y < CLUSTER_Y; y++) {
+            const float bottom = (-1.0F + 2.0F * static_cast<float>(y) / CLUSTER_Y) * yScale;
+            const float top = (-1.0F + 2.0F * static_cast<float>(y + 1) / CLUSTER_Y) * yScale;
+
+            for (unsigned int x = 0; x < CLUSTER_X; x++) {
+                const float left = (-1.0F + 2.0F * static_cast<float>(x) / CLUSTER_X) * xScale;
+                const float right = (-1.0F + 2.0F * static_cast<float>(x + 1) / CLUSTER_X) * xScale;
+
+                Cluster &cluster = clusters[x + y * CLUSTER_X + z * CLUSTER_X * CLUSTER_Y];
+
+                cluster.min = glm::vec3(std::min(left * sliceNear, left * sliceFar),
+                                        std::min(bottom * sliceNear, bottom * sliceFar), -sliceFar);
+                cluster.max = glm::vec3(std::max(right * sliceNear, right * sliceFar),
+                                        std::max(top * sliceNear, top * sliceFar), -sliceNear);
+            }
+        }
+    }
+}
+
+void LightClusters::binSlices(const unsigned int first, const unsigned int last) {
+    constexpr unsigned int sliceSize = CLUSTER_X * CLUSTER_Y;
+
+    for (unsigned int z = first; z < last; z++) {
+        auto &sliceList = sliceIndices[z];
+        sliceList.clear();
+
+        unsigned int dropped = 0;
+
+        const float sliceNear = -clusters[z * sliceSize].max.z;
+        const float sliceFar = -clusters[z * sliceSize].min.z;
+
+        for (unsigned int i = z * sliceSize; i < (z + 1) * sliceSize; i++) {
+            const Cluster &cluster = clusters[i];
+            const auto offset = static_cast<GLuint>(sliceList.size());
+            unsigned int count = 0;
+
+            for (const Sphere &sphere: spheres) {
+                if (-sphere.center.z + sphere.radius < sliceNear || -sphere.center.z - sphere.radius > sliceFar) {
+                    continue;
+                }
+
+                const glm::vec3 closest = glm::clamp(sphere.center, cluster.min, cluster.max);
+                const glm::vec3 delta = closest - sphere.center;
+
+                if (glm::dot(delta, delta) > sphere.radius * sphere.radius) {
+                    continue;
+                }
+
+                // keeps going past the cap only to count what the full cluster loses
+                if (count == MAX_LIGHTS_PER_CLUSTER) {
+                    dropped++;
+                    continue;
+                }
+
+                sliceList.push_back(sphere.index);
+                count++;
+            }
+
+            grid[i] = glm::uvec2(offset, count);
+        }
+
+        sliceOverflow[z] = dropped;
+    }
+}
+
+void LightClusters::work(const unsigned int first, const unsigned int last) {
+    PROFILE_THREAD("Light binning");
+    std::uint64_t seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock lock(poolMutex);
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+
+            if (stopping) {
+                return;
+            }
+
+            seen = generation;
+        }
+
+        binSlices(first, last);
+
+        const std::scoped_lock lock(poolMutex);
+        if (--running == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+auto LightClusters::Radius(const PointLight &light) -> float {
+    // distance at which the attenuated light drops below 5/256
+    const float brightest = std::max({light.diffuse.r, light.diffuse.g, light.diffuse.b, light.ambient.r,
+                                      light.ambient.g, light.ambient.b});
+    const float threshold = light.constant - brightest * (256.0F / 5.0F);
+
+    if (light.quadratic <= 0.0F) {
+        return light.linear > 0.0F ? -threshold / light.linear : std::numeric_limits<float>::max();
+    }
+
+    return (-light.linear + std::sqrt(light.linear * light.linear - 4.0F * light.quadratic * threshold)) /
+           (2.0F * light.quadratic);
+}
+
+void LightClusters::Upload(const GLuint buffer, const void *data, const GLsizeiptr size) {
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    // orphan the old store so we never wait on the previous frame
+    glBufferData(GL_TEXTURE_BUFFER, std::max<GLsizeiptr>(size, sizeof(glm::vec4)), nullptr, GL_STREAM_DRAW);
+    GpuMemory::Track(GpuMemory::Object::BUFFER, buffer, GpuMemory::Category::SHADER_DATA,
+                     static_cast<std::size_t>(std::max<GLsizeiptr>(size, sizeof(glm::vec4))), "Light clusters");
+    if (size > 0) {
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
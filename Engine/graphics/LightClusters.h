@@ -0,0 +1,124 @@
+//
+// Created by Jacob Edwards on 14/05/2024.
+//
+/*
+ * https://www.aortiz.me/2018/12/21/CG.html
+ * http://www.humus.name/Articles/PracticalClusteredShading.pdf
+ */
+
+#ifndef CW_LIGHTCLUSTERS_H
+#define CW_LIGHTCLUSTERS_H
+
+#include <GL/glew.h>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <glm/ext/vector_uint2.hpp>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "utils/Lights.h"
+
+constexpr unsigned int CLUSTER_X = 16;
+constexpr unsigned int CLUSTER_Y = 9;
+constexpr unsigned int CLUSTER_Z = 24;
+constexpr unsigned int CLUSTER_COUNT = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+
+// bounds the per fragment cost no matter how many lights are in the scene
+constexpr unsigned int MAX_LIGHTS_PER_CLUSTER = 32;
+
+// texture units the cluster buffers are bound to, after the shadow map on 10
+constexpr int POINT_LIGHT_UNIT = 11;
+constexpr int CLUSTER_GRID_UNIT = 12;
+constexpr int CLUSTER_INDEX_UNIT = 13;
+
+// bins point lights into a view space froxel grid, uploaded as texture buffers read by lights.glsl
+class LightClusters {
+public:
+    LightClusters();
+
+    ~LightClusters();
+
+    LightClusters(const LightClusters &) = delete;
+
+    auto operator=(const LightClusters &) -> LightClusters & = delete;
+
+    void update(std::span<const PointLight> lights, const glm::mat4 &view, const glm::mat4 &projection,
+                float near, float far, float width, float height);
+
+    // writes the grid parameters the shaders need into the lights block
+    void fill(Lights &lights) const;
+
+    void bind() const;
+
+    void interface() const;
+
+private:
+    struct Cluster {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    struct Sphere {
+        glm::vec3 center;
+        float radius;
+        unsigned int index;
+    };
+
+    GLuint lightBuffer = 0;
+    GLuint gridBuffer = 0;
+    GLuint indexBuffer = 0;
+
+    GLuint lightTexture = 0;
+    GLuint gridTexture = 0;
+    GLuint indexTexture = 0;
+
+    std::vector<Cluster> clusters;
+    std::vector<Sphere> spheres;
+
+    // offset and count into the index list for each cluster
+    std::vector<glm::uvec2> grid;
+    std::vector<GLuint> indices;
+
+    std::vector<std::vector<GLuint> > sliceIndices;
+    // lights that reached a cluster already at the cap, per slice so the workers never share a counter
+    std::array<unsigned int, CLUSTER_Z> sliceOverflow{};
+
+    // started once and parked between frames, each bins its own run of slices and the caller takes the first
+    std::vector<std::jthread> workers;
+    std::mutex poolMutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::uint64_t generation = 0;
+    unsigned int running = 0;
+    unsigned int slicesPerThread = CLUSTER_Z;
+    bool stopping = false;
+
+    glm::mat4 clusterProjection{0.0F};
+    float near = 0.0F;
+    float far = 0.0F;
+    float width = 0.0F;
+    float height = 0.0F;
+
+    unsigned int lightCount = 0;
+    unsigned int maxClusterLights = 0;
+    unsigned int overflow = 0;
+    float binTime = 0.0F;
+
+    void buildClusters();
+
+    void binSlices(unsigned int first, unsigned int last);
+
+    void work(unsigned int first, unsigned int last);
+
+    static auto Radius(const PointLight &light) -> float;
+
+    static void Upload(GLuint buffer, const void *data, GLsizeiptr size);
+};
+
+
+#endif //CW_LIGHTCLUSTERS_H
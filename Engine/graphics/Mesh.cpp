@@ -11,6 +11,7 @@
 #include <GL/glew.h>
 #include <cstdio>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,15 +19,35 @@
 #include <print>
 
 #include "graphics/buffers/VertexBuffer.h"
+#include "utils/FrameArena.h"
 
 Mesh::Mesh(std::vector<Vertex::Data> vertices, std::vector<GLuint> indices,
            std::vector<Texture::Data> textures, BoundingBox box, Material material)
     : textures(std::move(textures)), box(std::move(box)), material(material) {
     buffer = std::make_unique<VertexBuffer>();
+    buffer->owner = "Meshes";
     buffer->fill(std::move(vertices), std::move(indices));
 }
 
+Mesh::Mesh(const std::span<const Vertex::Data> vertices, const std::span<const GLuint> indices,
+           std::vector<Texture::Data> textures, BoundingBox box, Material material)
+    : textures(std::move(textures)), box(std::move(box)), material(material) {
+    buffer = std::make_unique<VertexBuffer>();
+    buffer->owner = "Meshes";
+    buffer->fill(vertices, indices);
+}
+
 void Mesh::draw(const std::shared_ptr<Shader> &shader) const {
+    bindMaterial(shader);
+
+    buffer->bind();
+    buffer->draw();
+    buffer->unbind();
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void Mesh::bindMaterial(const std::shared_ptr<Shader> &shader) const {
     GLuint diffuseNr = 1;
     GLuint specularNr = 1;
     GLuint normalNr = 1;
@@ -72,8 +93,12 @@ void Mesh::draw(const std::shared_ptr<Shader> &shader) const {
         }
 
         glBindTexture(GL_TEXTURE_2D, id);
-        shader->setUniform("material.texture_" + toString(type) + number,
-                           static_cast<GLint>(i + 1));
+
+        // too long for the small string buffer, so built in the frame arena instead of on the heap
+        FrameArena::String name("material.texture_", FrameArena::GetInstance().resource());
+        name += toString(type);
+        name += number;
+        shader->setUniform(name, static_cast<GLint>(i + 1));
     }
 
     // bind the material
@@ -82,12 +107,6 @@ void Mesh::draw(const std::shared_ptr<Shader> &shader) const {
     shader->setUniform("material.specular", material.specular);
     shader->setUniform("material.emissive", material.emissive);
     shader->setUniform("material.shininess", material.shininess);
-
-    buffer->bind();
-    buffer->draw();
-    buffer->unbind();
-
-    glActiveTexture(GL_TEXTURE0);
 }
 
 void Mesh::draw() const {
@@ -96,6 +115,10 @@ void Mesh::draw() const {
     buffer->unbind();
 }
 
+void Mesh::retain(const VertexBuffer::Retention retention) {
+    buffer->retain(retention);
+}
+
 auto Mesh::getBoundingBox() const -> BoundingBox { return box; }
 
 [[nodiscard]] auto Mesh::getTextures() const -> const std::vector<Texture::Data> & {
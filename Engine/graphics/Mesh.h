@@ -12,6 +12,7 @@
 #include <GL/glew.h>
 #include <glm/ext/vector_float3.hpp>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "graphics/Texture.h"
@@ -33,10 +34,20 @@ public:
     Mesh(std::vector<Vertex::Data> vertices, std::vector<GLuint> indices,
          std::vector<Texture::Data> textures, BoundingBox box, Material material);
 
+    // uploads straight from borrowed memory, such as a mapped mesh cache
+    Mesh(std::span<const Vertex::Data> vertices, std::span<const GLuint> indices,
+         std::vector<Texture::Data> textures, BoundingBox box, Material material);
+
     void draw(const std::shared_ptr<Shader> &shader) const;
 
     void draw() const;
 
+    // binds the textures and material uniforms without drawing, for callers that issue their own draw
+    void bindMaterial(const std::shared_ptr<Shader> &shader) const;
+
+    // drops the cpu copy of the geometry, draws keep working from the gpu's
+    void retain(VertexBuffer::Retention retention);
+
     [[nodiscard]] auto getBoundingBox() const -> BoundingBox;
 
     [[nodiscard]] auto getTextures() const -> const std::vector<Texture::Data> &;
@@ -0,0 +1,367 @@
+//
+// Created by Jacob Edwards on 17/05/2024.
+//
+
+#include "graphics/MeshCache.h"
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "graphics/Mesh.h"
+#include "graphics/Texture.h"
+#include "graphics/Vertex.h"
+#include "imgui/imgui.h"
+
+namespace {
+    const std::filesystem::path CACHE_DIRECTORY = "../Assets/cache";
+
+    constexpr std::array<char, 4> MAGIC = {'C', 'W', 'M', 'B'};
+
+    // blobs start on this boundary so they can be read in place
+    constexpr std::size_t ALIGNMENT = 16;
+
+    constexpr std::size_t MAX_TEXTURE_PATH = 256;
+
+    struct Header {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        std::int64_t sourceTime;
+        std::uint32_t flags;
+        std::uint32_t meshCount;
+        float importTime;
+        // a build whose vertex layout changed must not read the old one in place
+        std::uint32_t vertexSize;
+        // the canonical source path follows the records, two sources whose names hash alike can't swap
+        std::uint32_t sourceLength;
+        std::uint32_t padding;
+    };
+
+    struct MeshRecord {
+        std::uint64_t vertexOffset;
+        std::uint64_t indexOffset;
+        std::uint64_t textureOffset;
+        std::uint32_t vertexCount;
+        std::uint32_t indexCount;
+        std::uint32_t textureCount;
+        glm::vec3 min;
+        glm::vec3 max;
+        Material material;
+    };
+
+    struct TextureEntry {
+        Texture::Type type;
+        std::array<char, MAX_TEXTURE_PATH> path;
+    };
+
+    static_assert(std::is_trivially_copyable_v<Vertex::Data>);
+    static_assert(std::is_trivially_copyable_v<Material>);
+    static_assert(std::is_trivially_copyable_v<MeshRecord>);
+
+    struct LoadReport {
+        std::string source;
+        float importTime;
+        float cacheTime;
+    };
+
+    std::mutex reportMutex;
+    std::vector<LoadReport> reports;
+
+    auto Align(const std::size_t offset) -> std::size_t {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    // whether count elements of size bytes starting at offset lie inside the file. the values come straight
+    // from disk, so it is written so that nothing can wrap
+    auto Fits(const std::uint64_t offset, const std::uint64_t count, const std::size_t size, const std::size_t total)
+        -> bool {
+        return offset <= total && count <= (total - offset) / size;
+    }
+
+    auto SourceTime(const std::filesystem::path &source) -> std::int64_t {
+        std::error_code error;
+        const auto time = std::filesystem::last_write_time(source, error);
+        return error ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+
+    auto Canonical(const std::filesystem::path &source) -> std::string {
+        std::error_code error;
+        auto canonical = std::filesystem::weakly_canonical(source, error);
+        return error ? source.string() : canonical.string();
+    }
+
+    // one file per source and import flags, the header says whether it is still current
+    auto CachePath(const std::filesystem::path &source, const unsigned int flags) -> std::filesystem::path {
+        const auto hash = std::hash<std::string>{}(Canonical(source) + ":" + std::to_string(flags));
+        return CACHE_DIRECTORY / (source.stem().string() + "-" + std::to_string(hash) + ".mesh");
+    }
+}
+
+namespace MeshCache {
+    File::~File() {
+        unmap();
+    }
+
+    File::File(File &&other) noexcept : mapping(std::exchange(other.mapping, nullptr)),
+                                        size(std::exchange(other.size, 0)), meshes(std::move(other.meshes)),
+                                        importTime(other.importTime) {
+    }
+
+    auto File::operator=(File &&other) noexcept -> File & {
+        if (this != &other) {
+            unmap();
+            mapping = std::exchange(other.mapping, nullptr);
+            size = std::exchange(other.size, 0);
+            meshes = std::move(other.meshes);
+            importTime = other.importTime;
+        }
+
+        return *this;
+    }
+
+    auto File::getMeshes() const -> const std::vector<MeshView> & {
+        return meshes;
+    }
+
+    auto File::getImportTime() const -> float {
+        return importTime;
+    }
+
+    void File::unmap() {
+        if (mapping != nullptr) {
+            munmap(mapping, size);
+            mapping = nullptr;
+            size = 0;
+        }
+    }
+
+    auto Load(const std::filesystem::path &source, const unsigned int flags) -> std::optional<File> {
+        const auto path = CachePath(source, flags);
+
+        const int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor == -1) {
+            return std::nullopt;
+        }
+
+        std::error_code error;
+        const auto size = static_cast<std::size_t>(std::filesystem::file_size(path, error));
+
+        if (error || size < sizeof(Header)) {
+            close(descriptor);
+            return std::nullopt;
+        }
+
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+
+        if (mapping == MAP_FAILED) {
+            return std::nullopt;
+        }
+
+        File file;
+        file.mapping = mapping;
+        file.size = size;
+
+        const auto *bytes = static_cast<const std::byte *>(mapping);
+        Header header{};
+        std::memcpy(&header, bytes, sizeof(Header));
+
+        const std::size_t sourceOffset = sizeof(Header) + header.meshCount * sizeof(MeshRecord);
+
+        if (header.magic != MAGIC || header.version != VERSION || header.flags != flags ||
+            header.vertexSize != sizeof(Vertex::Data) || header.sourceTime != SourceTime(source) ||
+            sourceOffset + header.sourceLength > size) {
+            return std::nullopt;
+        }
+
+        const std::string_view baked(reinterpret_cast<const char *>(bytes + sourceOffset), header.sourceLength);
+        if (baked != Canonical(source)) {
+            return std::nullopt;
+        }
+
+        file.importTime = header.importTime;
+        file.meshes.reserve(header.meshCount);
+
+        for (std::uint32_t i = 0; i < header.meshCount; i++) {
+            MeshRecord record{};
+            std::memcpy(&record, bytes + sizeof(Header) + i * sizeof(MeshRecord), sizeof(MeshRecord));
+
+            if (!Fits(record.vertexOffset, record.vertexCount, sizeof(Vertex::Data), size) ||
+                !Fits(record.indexOffset, record.indexCount, sizeof(GLuint), size) ||
+                !Fits(record.textureOffset, record.textureCount, sizeof(TextureEntry), size) ||
+                record.vertexOffset % alignof(Vertex::Data) != 0 || record.indexOffset % alignof(GLuint) != 0) {
+                std::println(stderr, "Mesh cache {} is truncated", path.string());
+                return std::nullopt;
+            }
+
+            MeshView view;
+            view.vertices = {reinterpret_cast<const Vertex::Data *>(bytes + record.vertexOffset), record.vertexCount};
+            view.indices = {reinterpret_cast<const GLuint *>(bytes + record.indexOffset), record.indexCount};
+            view.min = record.min;
+            view.max = record.max;
+            view.material = record.material;
+
+            for (std::uint32_t j = 0; j < record.textureCount; j++) {
+                TextureEntry entry{};
+                std::memcpy(&entry, bytes + record.textureOffset + j * sizeof(TextureEntry), sizeof(TextureEntry));
+                entry.path.back() = '\0';
+                view.textures.push_back({entry.type, entry.path.data()});
+            }
+
+            file.meshes.push_back(std::move(view));
+        }
+
+        return file;
+    }
+
+    void Save(const std::filesystem::path &source, const unsigned int flags, const std::span<const MeshData> meshes,
+              const float importTime) {
+        std::error_code error;
+        std::filesystem::create_directories(CACHE_DIRECTORY, error);
+
+        const auto path = CachePath(source, flags);
+
+        // a cut off path would load as a different texture, better to import this model every time
+        for (const auto &mesh: meshes) {
+            for (const auto &texture: mesh.textures) {
+                if (texture.path.size() >= MAX_TEXTURE_PATH) {
+                    std::println(stderr, "Not caching {}, texture path {} is over {} characters", source.string(),
+                                 texture.path, MAX_TEXTURE_PATH - 1);
+                    return;
+                }
+            }
+        }
+
+        const auto canonical = Canonical(source);
+
+        // lay out the records first so every blob offset is known before writing
+        std::vector<MeshRecord> records(meshes.size());
+        const std::size_t sourceOffset = sizeof(Header) + meshes.size() * sizeof(MeshRecord);
+        std::size_t offset = Align(sourceOffset + canonical.size());
+
+        for (std::size_t i = 0; i < meshes.size(); i++) {
+            const auto &mesh = meshes[i];
+            auto &record = records[i];
+
+            record.textureOffset = offset;
+            record.textureCount = static_cast<std::uint32_t>(mesh.textures.size());
+            offset = Align(offset + mesh.textures.size() * sizeof(TextureEntry));
+
+            record.vertexOffset = offset;
+            record.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+            offset = Align(offset + mesh.vertices.size_bytes());
+
+            record.indexOffset = offset;
+            record.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+            offset = Align(offset + mesh.indices.size_bytes());
+
+            record.min = mesh.min;
+            record.max = mesh.max;
+            record.material = mesh.material;
+        }
+
+        std::vector<std::byte> buffer(offset);
+
+        const Header header{MAGIC, VERSION, SourceTime(source), flags, static_cast<std::uint32_t>(meshes.size()),
+                            importTime, sizeof(Vertex::Data), static_cast<std::uint32_t>(canonical.size()), 0};
+        std::memcpy(buffer.data(), &header, sizeof(Header));
+        std::memcpy(buffer.data() + sizeof(Header), records.data(), records.size() * sizeof(MeshRecord));
+        std::memcpy(buffer.data() + sourceOffset, canonical.data(), canonical.size());
+
+        for (std::size_t i = 0; i < meshes.size(); i++) {
+            const auto &mesh = meshes[i];
+            const auto &record = records[i];
+
+            for (std::size_t j = 0; j < mesh.textures.size(); j++) {
+                TextureEntry entry{mesh.textures[j].type, {}};
+                mesh.textures[j].path.copy(entry.path.data(), MAX_TEXTURE_PATH - 1);
+                std::memcpy(buffer.data() + record.textureOffset + j * sizeof(TextureEntry), &entry,
+                            sizeof(TextureEntry));
+            }
+
+            std::memcpy(buffer.data() + record.vertexOffset, mesh.vertices.data(), mesh.vertices.size_bytes());
+            std::memcpy(buffer.data() + record.indexOffset, mesh.indices.data(), mesh.indices.size_bytes());
+        }
+
+        // written beside the real file and renamed over it, so a crash never leaves half a cache behind
+        auto temporary = path;
+        temporary += ".tmp";
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::println(stderr, "Could not write mesh cache {}", path.string());
+                return;
+            }
+            file.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::println(stderr, "Could not write mesh cache {}: {}", path.string(), error.message());
+        }
+    }
+
+    void Report(const std::filesystem::path &source, const float importTime, const float cacheTime) {
+        const std::scoped_lock lock(reportMutex);
+        reports.push_back({source.filename().string(), importTime, cacheTime});
+    }
+
+    void Interface() {
+        const std::scoped_lock lock(reportMutex);
+
+        ImGui::Begin("Mesh Cache");
+
+        float cold = 0.0F;
+        float warm = 0.0F;
+
+        if (ImGui::BeginTable("Loads", 3)) {
+            ImGui::TableSetupColumn("Model");
+            ImGui::TableSetupColumn("Cold (ms)");
+            ImGui::TableSetupColumn("Warm (ms)");
+            ImGui::TableHeadersRow();
+
+            for (const auto &[source, importTime, cacheTime]: reports) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(source.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", importTime);
+                ImGui::TableNextColumn();
+                if (cacheTime > 0.0F) {
+                    ImGui::Text("%.2f", cacheTime);
+                } else {
+                    ImGui::TextUnformatted("-");
+                }
+
+                cold += importTime;
+                warm += cacheTime > 0.0F ? cacheTime : importTime;
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::Text("Total: %.1f ms cold, %.1f ms warm", cold, warm);
+        ImGui::End();
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by Jacob Edwards on 17/05/2024.
+//
+
+#ifndef CW_MESHCACHE_H
+#define CW_MESHCACHE_H
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include <glm/ext/vector_float3.hpp>
+
+#include "graphics/Mesh.h"
+#include "graphics/Texture.h"
+#include "graphics/Vertex.h"
+
+// baked copies of imported models, so assimp only runs the first time a model is seen.
+// a baked file is a header, one record per mesh, then the texture, vertex and index blobs, all read
+// straight out of a memory mapping. stale when the source path or mtime, import flags, vertex layout or
+// format version change
+namespace MeshCache {
+    constexpr std::uint32_t VERSION = 2;
+
+    struct TextureRecord {
+        Texture::Type type;
+        std::string path;
+    };
+
+    // views into the mapped file, only valid while the File it came from is alive
+    struct MeshView {
+        std::span<const Vertex::Data> vertices;
+        std::span<const GLuint> indices;
+        std::vector<TextureRecord> textures;
+        glm::vec3 min;
+        glm::vec3 max;
+        Material material;
+    };
+
+    // what a fresh import produced, written out by Save
+    struct MeshData {
+        std::span<const Vertex::Data> vertices;
+        std::span<const GLuint> indices;
+        std::span<const TextureRecord> textures;
+        glm::vec3 min;
+        glm::vec3 max;
+        Material material;
+    };
+
+    class File {
+    public:
+        File() = default;
+
+        ~File();
+
+        File(const File &) = delete;
+
+        auto operator=(const File &) -> File & = delete;
+
+        File(File &&other) noexcept;
+
+        auto operator=(File &&other) noexcept -> File &;
+
+        [[nodiscard]] auto getMeshes() const -> const std::vector<MeshView> &;
+
+        // how long assimp took when this file was baked
+        [[nodiscard]] auto getImportTime() const -> float;
+
+    private:
+        friend auto Load(const std::filesystem::path &source, unsigned int flags) -> std::optional<File>;
+
+        void *mapping = nullptr;
+        std::size_t size = 0;
+        std::vector<MeshView> meshes;
+        float importTime = 0.0F;
+
+        void unmap();
+    };
+
+    auto Load(const std::filesystem::path &source, unsigned int flags) -> std::optional<File>;
+
+    void Save(const std::filesystem::path &source, unsigned int flags, std::span<const MeshData> meshes,
+              float importTime);
+
+    // records a model load for the startup report, models are imported from several threads at once
+    void Report(const std::filesystem::path &source, float importTime, float cacheTime);
+
+    void Interface();
+}
+
+
+#endif //CW_MESHCACHE_H
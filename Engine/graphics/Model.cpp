@@ -8,6 +8,7 @@
 #include <assimp/material.h>
 #include <assimp/mesh.h>
 #include <assimp/types.h>
+#include <chrono>
 #include <cstdio>
 #include <glm/common.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
@@ -15,6 +16,7 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <span>
 #include <stack>
 #include <string>
 #include <utility>
@@ -28,13 +30,34 @@
 
 #include "graphics/Mesh.h"
 #include "graphics/Texture.h"
+#include "graphics/MeshCache.h"
 #include "helpers/AssimpGLMHelpers.h"
+#include "utils/Allocations.h"
 #include "utils/BoundingBox.h"
+#include "utils/Profiler.h"
 #include "graphics/Shader.h"
 #include "graphics/Vertex.h"
+#include "utils/StartupTimeline.h"
+#include "utils/TextureManager.h"
+#include "App.h"
 
-Model::Model(const std::filesystem::path &path) : path(path) {
-    loadModel(path);
+Model::Model(const std::filesystem::path &path) : Model(Read(path)) {
+}
+
+Model::Model(Import import) : directory(import.path.parent_path()), path(std::move(import.path)) {
+    if (import.cache.has_value()) {
+        for (const auto &[vertices, indices, records, min, max, material]: import.cache->getMeshes()) {
+            meshes.push_back(std::make_unique<Mesh>(vertices, indices, loadTextures(records), BoundingBox{min, max},
+                                                    material));
+        }
+
+        return;
+    }
+
+    for (auto &[vertices, indices, records, min, max, material]: import.parts) {
+        meshes.push_back(std::make_unique<Mesh>(std::move(vertices), std::move(indices), loadTextures(records),
+                                                BoundingBox{min, max}, material));
+    }
 }
 
 void Model::draw(const std::shared_ptr<Shader> shader) const {
@@ -55,26 +78,50 @@ void Model::draw(const glm::mat4 &view, const glm::mat4 &projection) const {
     }
 }
 
-void Model::loadModel(const std::filesystem::path &path) {
+auto Model::Read(const std::filesystem::path &path) -> Import {
+    PROFILE_ZONE("Model import");
+    ALLOCATION_SCOPE(ASSETS);
+    const StartupTimeline::Scope scope("Import " + path.filename().string());
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    Import import{path, {}, MeshCache::Load(path, IMPORT_FLAGS)};
+
+    if (import.cache.has_value()) {
+        const auto end = std::chrono::high_resolution_clock::now();
+        MeshCache::Report(path, import.cache->getImportTime(),
+                          std::chrono::duration<float, std::milli>(end - start).count());
+        return import;
+    }
+
     Assimp::Importer importer;
-    const aiScene *scene = importer.ReadFile(
-        path.string(), aiProcess_Triangulate | aiProcess_GenSmoothNormals |
-                       aiProcess_FlipUVs | aiProcess_CalcTangentSpace |
-                       aiProcess_GenBoundingBoxes | aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph);
+    const aiScene *scene = importer.ReadFile(path.string(), IMPORT_FLAGS);
 
     if (scene == nullptr ||
         (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0U ||
         scene->mRootNode == nullptr) {
         std::println(stderr, "ERROR::ASSIMP::{}", importer.GetErrorString());
-        return;
+        return import;
+    }
+
+    ProcessNode(scene->mRootNode, scene, import.parts);
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    const float importTime = std::chrono::duration<float, std::milli>(end - start).count();
+
+    std::vector<MeshCache::MeshData> baked;
+    baked.reserve(import.parts.size());
+
+    for (const auto &[vertices, indices, textures, min, max, material]: import.parts) {
+        baked.push_back({vertices, indices, textures, min, max, material});
     }
 
-    directory = path.parent_path();
+    MeshCache::Save(path, IMPORT_FLAGS, baked, importTime);
+    MeshCache::Report(path, importTime, 0.0F);
 
-    processNode(scene->mRootNode, scene);
+    return import;
 }
 
-void Model::processNode(const aiNode *const node, const aiScene *scene) {
+void Model::ProcessNode(const aiNode *const node, const aiScene *scene, std::vector<Import::Part> &parts) {
     std::stack<const aiNode *> nodeStack;
     nodeStack.push(node);
 
@@ -83,8 +130,8 @@ void Model::processNode(const aiNode *const node, const aiScene *scene) {
         nodeStack.pop();
 
         for (unsigned int i = 0; i < currentNode->mNumMeshes; ++i) {
-            aiMesh *mesh = scene->mMeshes[currentNode->mMeshes[i]];
-            meshes.push_back(std::make_unique<Mesh>(processMesh(mesh, scene)));
+            const aiMesh *mesh = scene->mMeshes[currentNode->mMeshes[i]];
+            parts.push_back(ProcessMesh(mesh, scene));
         }
 
         for (unsigned int i = 0; i < currentNode->mNumChildren; i++) {
@@ -93,15 +140,10 @@ void Model::processNode(const aiNode *const node, const aiScene *scene) {
     }
 }
 
-auto Model::processMesh(aiMesh *mesh, const aiScene *scene) -> Mesh {
+auto Model::ProcessMesh(const aiMesh *mesh, const aiScene *scene) -> Import::Part {
     std::vector<Vertex::Data> vertices;
     std::vector<GLuint> indices;
-    std::vector<Texture::Data> textures;
-
-    const BoundingBox box{
-        AssimpGLMHelpers::getGLMVec(mesh->mAABB.mMin),
-        AssimpGLMHelpers::getGLMVec(mesh->mAABB.mMax)
-    };
+    std::vector<MeshCache::TextureRecord> textures;
 
     for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
         Vertex::Data vertex{};
@@ -141,32 +183,14 @@ auto Model::processMesh(aiMesh *mesh, const aiScene *scene) -> Mesh {
         }
     }
 
-    aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
-
-    std::vector<Texture::Data> diffuseMaps = loadMaterialTextures(
-        material, aiTextureType_DIFFUSE, Texture::Type::DIFFUSE);
-    textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-    // 2. specular maps
-    std::vector<Texture::Data> specularMaps = loadMaterialTextures(
-        material, aiTextureType_SPECULAR, Texture::Type::SPECULAR);
-    textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
-    // 3. height maps
-    std::vector<Texture::Data> heightMaps = loadMaterialTextures(
-        material, aiTextureType_HEIGHT, Texture::Type::HEIGHT);
-    textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
-    // 4. normal maps
-    std::vector<Texture::Data> normalMaps = loadMaterialTextures(
-        material, aiTextureType_NORMALS, Texture::Type::NORMAL);
-    textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
-    // 5. ambient occlusion maps
-    std::vector<Texture::Data> ambientOcclusionMaps = loadMaterialTextures(
-        material, aiTextureType_AMBIENT, Texture::Type::AMBIENT_OCCLUSION);
-    textures.insert(textures.end(), ambientOcclusionMaps.begin(),
-                    ambientOcclusionMaps.end());
-    // 6. emissive maps
-    std::vector<Texture::Data> emissiveMaps = loadMaterialTextures(
-        material, aiTextureType_EMISSIVE, Texture::Type::EMISSIVE);
-    textures.insert(textures.end(), emissiveMaps.begin(), emissiveMaps.end());
+    const aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
+
+    ReadMaterialTextures(material, aiTextureType_DIFFUSE, Texture::Type::DIFFUSE, textures);
+    ReadMaterialTextures(material, aiTextureType_SPECULAR, Texture::Type::SPECULAR, textures);
+    ReadMaterialTextures(material, aiTextureType_HEIGHT, Texture::Type::HEIGHT, textures);
+    ReadMaterialTextures(material, aiTextureType_NORMALS, Texture::Type::NORMAL, textures);
+    ReadMaterialTextures(material, aiTextureType_AMBIENT, Texture::Type::AMBIENT_OCCLUSION, textures);
+    ReadMaterialTextures(material, aiTextureType_EMISSIVE, Texture::Type::EMISSIVE, textures);
 
     // get material properties
     aiColor4D color(0.0F, 0.0F, 0.0F, 0.0F);
@@ -187,38 +211,50 @@ auto Model::processMesh(aiMesh *mesh, const aiScene *scene) -> Mesh {
 
     const Material meshMaterial = {ambient, diffuse, specular, emissive, shininess};
 
-    return {vertices, indices, textures, box, meshMaterial};
+    return {
+        std::move(vertices), std::move(indices), std::move(textures),
+        AssimpGLMHelpers::getGLMVec(mesh->mAABB.mMin), AssimpGLMHelpers::getGLMVec(mesh->mAABB.mMax), meshMaterial
+    };
 }
 
-auto Model::loadMaterialTextures(const aiMaterial *const mat,
-                                 const aiTextureType type,
-                                 const Texture::Type texType)
-    -> std::vector<Texture::Data> {
-    std::vector<Texture::Data> textures;
-
+void Model::ReadMaterialTextures(const aiMaterial *const mat, const aiTextureType type, const Texture::Type texType,
+                                 std::vector<MeshCache::TextureRecord> &textures) {
     for (unsigned int i = 0; i < mat->GetTextureCount(type); i++) {
         aiString str;
         mat->GetTexture(type, i, &str);
 
-        const std::string path(str.C_Str());
+        textures.push_back({texType, str.C_Str()});
+    }
+}
 
-        if (const auto loaded = texturesLoaded.find(path); loaded != texturesLoaded.end()) {
-            textures.push_back(loaded->second);
-            continue;
-        }
+auto Model::loadTextures(const std::span<const MeshCache::TextureRecord> records) -> std::vector<Texture::Data> {
+    std::vector<Texture::Data> textures;
+
+    // nothing to sample them headless, and decoding them would only slow the start down
+    if (App::headless) {
+        return textures;
+    }
 
-        const Texture::Data texture{
-            Texture::Loader::load(path, directory), texType,
-            str.C_Str()
-        };
+    textures.reserve(records.size());
 
-        textures.push_back(texture);
-        texturesLoaded[path] = texture;
+    for (const auto &[type, texturePath]: records) {
+        textures.push_back(loadTexture(texturePath, type));
     }
 
     return textures;
 }
 
+auto Model::loadTexture(const std::string &path, const Texture::Type type) -> Texture::Data {
+    if (const auto loaded = texturesLoaded.find(path); loaded != texturesLoaded.end()) {
+        return {loaded->second->id, type, path};
+    }
+
+    const auto texture = TextureManager::GetInstance().load(directory / path);
+    texturesLoaded.emplace(path, texture);
+
+    return {texture->id, type, path};
+}
+
 [[nodiscard]] auto Model::getBoundingBox() const -> BoundingBox {
     if (boundingBox != nullptr) {
         return *boundingBox;
@@ -253,3 +289,9 @@ auto Model::loadMaterialTextures(const aiMaterial *const mat,
 [[nodiscard]] auto Model::getMeshes() const -> const std::vector<std::unique_ptr<Mesh> > & {
     return meshes;
 }
+
+void Model::retain(const VertexBuffer::Retention retention) {
+    for (const auto &mesh: meshes) {
+        mesh->retain(retention);
+    }
+}
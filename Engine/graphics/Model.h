@@ -13,27 +13,56 @@
 #include <assimp/mesh.h>
 #include <glm/ext/matrix_float4x4.hpp>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <filesystem>
 
 #include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
 #include "Mesh.h"
+#include "graphics/MeshCache.h"
 #include "graphics/Texture.h"
 #include "physics/ModelAttributes.h"
 #include "utils/BoundingBox.h"
 #include "graphics/Shader.h"
 #include "renderables/Renderable.h"
+#include "utils/TextureManager.h"
 
 class Model final : public Renderable {
 public:
+    // everything a load produces before gl is involved, so it can be built on a worker thread
+    struct Import {
+        struct Part {
+            std::vector<Vertex::Data> vertices;
+            std::vector<GLuint> indices;
+            std::vector<MeshCache::TextureRecord> textures;
+            glm::vec3 min;
+            glm::vec3 max;
+            Material material;
+        };
+
+        std::filesystem::path path;
+        // a fresh assimp import, empty when the cache was warm
+        std::vector<Part> parts;
+        // the cache's views stay mapped until the model has been built from them
+        std::optional<MeshCache::File> cache;
+    };
+
     Physics::Attributes attributes;
 
     explicit Model(const std::filesystem::path &path);
 
+    // the gl half of a load, uploads the meshes and requests the textures
+    explicit Model(Import import);
+
+    // the cpu half of a load, touches no gl state so it's safe off the main thread
+    static auto Read(const std::filesystem::path &path) -> Import;
+
     void draw(const glm::mat4 &view, const glm::mat4 &projection) const override;
 
     void draw(std::shared_ptr<Shader> shader) const override;
@@ -42,22 +71,33 @@ public:
 
     [[nodiscard]] auto getMeshes() const -> const std::vector<std::unique_ptr<Mesh> > &;
 
+    // once nothing else is going to be baked from it, the cpu copies of every mesh can go
+    void retain(VertexBuffer::Retention retention);
+
 private:
-    std::unordered_map<std::string, Texture::Data> texturesLoaded;
+    // part of the mesh cache key, changing these rebakes every model
+    static constexpr unsigned int IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_GenSmoothNormals |
+                                                 aiProcess_FlipUVs | aiProcess_CalcTangentSpace |
+                                                 aiProcess_GenBoundingBoxes | aiProcess_OptimizeMeshes |
+                                                 aiProcess_OptimizeGraph;
+
+    // holding the handles keeps the shared textures resident while this model is alive
+    std::unordered_map<std::string, TextureManager::Handle> texturesLoaded;
     std::vector<std::unique_ptr<Mesh> > meshes;
     std::filesystem::path directory;
     std::filesystem::path path;
     std::shared_ptr<BoundingBox> boundingBox;
 
-    void loadModel(const std::filesystem::path &path);
+    auto loadTextures(std::span<const MeshCache::TextureRecord> records) -> std::vector<Texture::Data>;
+
+    auto loadTexture(const std::string &path, Texture::Type type) -> Texture::Data;
 
-    void processNode(const aiNode *node, const aiScene *scene);
+    static void ProcessNode(const aiNode *node, const aiScene *scene, std::vector<Import::Part> &parts);
 
-    auto processMesh(aiMesh *mesh, const aiScene *scene) -> Mesh;
+    static auto ProcessMesh(const aiMesh *mesh, const aiScene *scene) -> Import::Part;
 
-    auto loadMaterialTextures(const aiMaterial *mat, aiTextureType type,
-                              Texture::Type texType)
-        -> std::vector<Texture::Data>;
+    static void ReadMaterialTextures(const aiMaterial *mat, aiTextureType type, Texture::Type texType,
+                                     std::vector<MeshCache::TextureRecord> &textures);
 };
 
 #endif // MODEL_H
@@ -50,6 +50,12 @@ void PostProcess::render(const float deltaTime) {
     }
     shader->setUniform("screenTexture", 0);
 
+    // depth from the main pass, resolved in FrameBuffer::unbind when multisampled
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, frameBuffer->getDepthTexture());
+    shader->setUniform("depthTexture", 1);
+    glActiveTexture(GL_TEXTURE0);
+
     renderPlane.draw();
     frameBuffer->unbind();
     glEnable(GL_DEPTH_TEST);
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -74,12 +75,12 @@ void Shader::reload() {
 [[nodiscard]] auto Shader::getProgramID() const -> GLuint { return ID; }
 
 template<typename T>
-void Shader::setUniform(const std::string &name, T /*value*/) {
+void Shader::setUniform(const std::string_view name, T /*value*/) {
     std::println(stderr, "Invalid type for uniform {}", name);
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::mat4 value) {
+void Shader::setUniform(const std::string_view name, const glm::mat4 value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
@@ -87,8 +88,8 @@ void Shader::setUniform(const std::string &name, const glm::mat4 value) {
 
         glUniformMatrix4fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
 
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader {}", name, vertexPath.c_str());
@@ -99,15 +100,15 @@ void Shader::setUniform(const std::string &name, const glm::mat4 value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::mat3 value) {
+void Shader::setUniform(const std::string_view name, const glm::mat3 value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniformMatrix3fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
 
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader {}", name, vertexPath.c_str());
@@ -118,15 +119,15 @@ void Shader::setUniform(const std::string &name, const glm::mat3 value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::vec4 value) {
+void Shader::setUniform(const std::string_view name, const glm::vec4 value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform4fv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
 
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader {}", name, vertexPath.c_str());
@@ -137,15 +138,15 @@ void Shader::setUniform(const std::string &name, const glm::vec4 value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::vec3 value) {
+void Shader::setUniform(const std::string_view name, const glm::vec3 value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform3fv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
 
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader {}", name, vertexPath.c_str());
@@ -156,15 +157,15 @@ void Shader::setUniform(const std::string &name, const glm::vec3 value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::vec2 value) {
+void Shader::setUniform(const std::string_view name, const glm::vec2 value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform2fv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader {}", name, vertexPath.c_str());
         } else {
@@ -174,15 +175,15 @@ void Shader::setUniform(const std::string &name, const glm::vec2 value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const float value) {
+void Shader::setUniform(const std::string_view name, const float value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform1f(it->second, value);
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader {}", name, vertexPath.c_str());
         } else {
@@ -192,15 +193,15 @@ void Shader::setUniform(const std::string &name, const float value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const int value) {
+void Shader::setUniform(const std::string_view name, const int value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform1i(it->second, value);
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader {}", name, vertexPath.c_str());
         } else {
@@ -210,7 +211,7 @@ void Shader::setUniform(const std::string &name, const int value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const unsigned int value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -218,8 +219,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniform1ui(it->second, value);
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -229,15 +230,15 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const bool value) {
+void Shader::setUniform(const std::string_view name, const bool value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform1i(it->second, static_cast<GLint>(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -247,7 +248,7 @@ void Shader::setUniform(const std::string &name, const bool value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::ivec2 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -255,8 +256,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniform2iv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -266,7 +267,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::ivec3 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -274,8 +275,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniform3iv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -285,7 +286,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::ivec4 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -293,8 +294,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniform4iv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -304,7 +305,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::uvec2 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -312,8 +313,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniform2uiv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -323,7 +324,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::uvec3 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -331,8 +332,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniform3uiv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -342,7 +343,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::uvec4 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -350,8 +351,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniform4uiv(it->second, 1, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -361,15 +362,15 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::mat2 &value) {
+void Shader::setUniform(const std::string_view name, const glm::mat2 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniformMatrix2fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -379,7 +380,7 @@ void Shader::setUniform(const std::string &name, const glm::mat2 &value) {
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::mat2x3 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -387,8 +388,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix2x3fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -398,7 +399,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::mat2x4 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -406,8 +407,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix2x4fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -417,7 +418,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::mat3x2 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -425,8 +426,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix3x2fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -436,7 +437,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::mat3x4 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -444,8 +445,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix3x4fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -455,7 +456,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::mat4x2 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -463,8 +464,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix4x2fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -474,7 +475,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::mat4x3 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -482,8 +483,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix4x3fv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -493,7 +494,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::dmat2 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -501,8 +502,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix2dv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -512,7 +513,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::dmat3 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -520,8 +521,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix3dv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -531,7 +532,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::dmat4 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -539,8 +540,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix4dv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -550,7 +551,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::dmat2x3 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -558,8 +559,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix2x3dv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -569,7 +570,7 @@ void Shader::setUniform(const std::string &name,
 }
 
 template<>
-void Shader::setUniform(const std::string &name,
+void Shader::setUniform(const std::string_view name,
                         const glm::dmat2x4 &value) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
@@ -577,8 +578,8 @@ void Shader::setUniform(const std::string &name,
         }
         glUniformMatrix2x4dv(it->second, 1, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -589,20 +590,20 @@ void Shader::setUniform(const std::string &name,
 
 
 template<typename T>
-void Shader::setUniform(const std::string &name, T /*value*/, std::size_t /*count*/) {
+void Shader::setUniform(const std::string_view name, T /*value*/, std::size_t /*count*/) {
     std::println(stderr, "Invalid type for uniform {}", name);
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::mat4 value, const std::size_t count) {
+void Shader::setUniform(const std::string_view name, const glm::mat4 value, const std::size_t count) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniformMatrix4fv(it->second, count, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
@@ -612,76 +613,76 @@ void Shader::setUniform(const std::string &name, const glm::mat4 value, const st
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::mat3 value, const std::size_t count) {
+void Shader::setUniform(const std::string_view name, const glm::mat3 value, const std::size_t count) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniformMatrix3fv(it->second, count, GL_FALSE, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
-            uniformLocations[name] = location;
+            uniformLocations.insert_or_assign(std::string(name), location);
             glUniformMatrix3fv(location, count, GL_FALSE, value_ptr(value));
         }
     }
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::vec4 value, const std::size_t count) {
+void Shader::setUniform(const std::string_view name, const glm::vec4 value, const std::size_t count) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform4fv(it->second, count, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
-            uniformLocations[name] = location;
+            uniformLocations.insert_or_assign(std::string(name), location);
             glUniform4fv(location, count, value_ptr(value));
         }
     }
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::vec3 value, const std::size_t count) {
+void Shader::setUniform(const std::string_view name, const glm::vec3 value, const std::size_t count) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform3fv(it->second, count, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
-            uniformLocations[name] = location;
+            uniformLocations.insert_or_assign(std::string(name), location);
             glUniform3fv(location, count, value_ptr(value));
         }
     }
 }
 
 template<>
-void Shader::setUniform(const std::string &name, const glm::vec2 value, const std::size_t count) {
+void Shader::setUniform(const std::string_view name, const glm::vec2 value, const std::size_t count) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         if (it->second == -1) {
             return;
         }
         glUniform2fv(it->second, count, value_ptr(value));
     } else {
-        const GLint location = glGetUniformLocation(ID, name.c_str());
-        uniformLocations[name] = location;
+        const GLint location = glGetUniformLocation(ID, std::string(name).c_str());
+        uniformLocations.insert_or_assign(std::string(name), location);
         if (location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
-            uniformLocations[name] = location;
+            uniformLocations.insert_or_assign(std::string(name), location);
             glUniform2fv(location, count, value_ptr(value));
         }
     }
@@ -689,217 +690,217 @@ void Shader::setUniform(const std::string &name, const glm::vec2 value, const st
 
 
 template<typename T>
-auto Shader::getUniform(const std::string &name) const -> T {
+auto Shader::getUniform(const std::string_view name) const -> T {
     std::println(stderr, "Invalid type for uniform {}", name);
 
     return nullptr;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat4 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat4 {
     glm::mat4 value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformfv(ID, it->second, value_ptr(value));
     } else {
-        glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+        glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat3 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat3 {
     glm::mat3 value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformfv(ID, it->second, value_ptr(value));
     } else {
-        glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+        glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::vec4 {
+auto Shader::getUniform(const std::string_view name) const -> glm::vec4 {
     glm::vec4 value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformfv(ID, it->second, value_ptr(value));
     } else {
-        glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+        glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::vec3 {
+auto Shader::getUniform(const std::string_view name) const -> glm::vec3 {
     glm::vec3 value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformfv(ID, it->second, value_ptr(value));
     } else {
-        glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+        glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::vec2 {
+auto Shader::getUniform(const std::string_view name) const -> glm::vec2 {
     glm::vec2 value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformfv(ID, it->second, value_ptr(value));
     } else {
-        glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+        glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> float {
+auto Shader::getUniform(const std::string_view name) const -> float {
     float value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformfv(ID, it->second, &value);
     } else {
-        glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), &value);
+        glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), &value);
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> int {
+auto Shader::getUniform(const std::string_view name) const -> int {
     int value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformiv(ID, it->second, &value);
     } else {
-        glGetUniformiv(ID, glGetUniformLocation(ID, name.c_str()), &value);
+        glGetUniformiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), &value);
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> GLuint {
+auto Shader::getUniform(const std::string_view name) const -> GLuint {
     GLuint value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformuiv(ID, it->second, &value);
     } else {
-        glGetUniformuiv(ID, glGetUniformLocation(ID, name.c_str()), &value);
+        glGetUniformuiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), &value);
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> bool {
+auto Shader::getUniform(const std::string_view name) const -> bool {
     int value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformiv(ID, it->second, &value);
     } else {
-        glGetUniformiv(ID, glGetUniformLocation(ID, name.c_str()), &value);
+        glGetUniformiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), &value);
     }
     return static_cast<bool>(value);
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::ivec2 {
+auto Shader::getUniform(const std::string_view name) const -> glm::ivec2 {
     glm::ivec2 value;
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glGetUniformiv(ID, it->second, value_ptr(value));
     } else {
-        glGetUniformiv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+        glGetUniformiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     }
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::ivec3 {
+auto Shader::getUniform(const std::string_view name) const -> glm::ivec3 {
     glm::ivec3 value;
-    glGetUniformiv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::ivec4 {
+auto Shader::getUniform(const std::string_view name) const -> glm::ivec4 {
     glm::ivec4 value;
-    glGetUniformiv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::uvec2 {
+auto Shader::getUniform(const std::string_view name) const -> glm::uvec2 {
     glm::uvec2 value;
-    glGetUniformuiv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformuiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::uvec3 {
+auto Shader::getUniform(const std::string_view name) const -> glm::uvec3 {
     glm::uvec3 value;
-    glGetUniformuiv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformuiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::uvec4 {
+auto Shader::getUniform(const std::string_view name) const -> glm::uvec4 {
     glm::uvec4 value;
-    glGetUniformuiv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformuiv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat2 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat2 {
     glm::mat2 value;
-    glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat2x3 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat2x3 {
     glm::mat2x3 value;
-    glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat2x4 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat2x4 {
     glm::mat2x4 value;
-    glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat3x2 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat3x2 {
     glm::mat3x2 value;
-    glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat3x4 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat3x4 {
     glm::mat3x4 value;
-    glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat4x2 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat4x2 {
     glm::mat4x2 value;
-    glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::mat4x3 {
+auto Shader::getUniform(const std::string_view name) const -> glm::mat4x3 {
     glm::mat4x3 value;
-    glGetUniformfv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformfv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::dmat2 {
+auto Shader::getUniform(const std::string_view name) const -> glm::dmat2 {
     glm::dmat2 value;
-    glGetUniformdv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformdv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
 template<>
-auto Shader::getUniform(const std::string &name) const -> glm::dmat3 {
+auto Shader::getUniform(const std::string_view name) const -> glm::dmat3 {
     glm::dmat3 value;
-    glGetUniformdv(ID, glGetUniformLocation(ID, name.c_str()), value_ptr(value));
+    glGetUniformdv(ID, glGetUniformLocation(ID, std::string(name).c_str()), value_ptr(value));
     return value;
 }
 
@@ -1044,18 +1045,18 @@ void Shader::load() {
     }
 }
 
-void Shader::setVec3Array(const std::string &name, const std::vector<glm::vec3> &values) {
+void Shader::setVec3Array(const std::string_view name, const std::vector<glm::vec3> &values) {
     if (const auto it = uniformLocations.find(name); it != uniformLocations.end()) {
         glUniform3fv(it->second, static_cast<GLsizei>(values.size()), &values[0][0]);
     } else {
-        if (const GLint location = glGetUniformLocation(ID, name.c_str()); location == -1) {
+        if (const GLint location = glGetUniformLocation(ID, std::string(name).c_str()); location == -1) {
             std::println(stderr, "Uniform {} not found in shader", name);
         } else {
-            uniformLocations[name] = location;
+            uniformLocations.insert_or_assign(std::string(name), location);
             glUniform3fv(location, static_cast<GLsizei>(values.size()), &values[0][0]);
         }
     }
 
-    const auto location = glGetUniformLocation(ID, name.c_str());
+    const auto location = glGetUniformLocation(ID, std::string(name).c_str());
     glUniform3fv(location, static_cast<GLsizei>(values.size()), &values[0][0]);
 }
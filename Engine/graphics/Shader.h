@@ -13,7 +13,9 @@
 
 
 #include <filesystem>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -44,15 +46,15 @@ public:
     [[nodiscard]] auto getProgramID() const -> GLuint;
 
     template<typename T>
-    void setUniform(const std::string &name, T value);
+    void setUniform(std::string_view name, T value);
 
     template<typename T>
-    void setUniform(const std::string &name, T value, std::size_t count);
+    void setUniform(std::string_view name, T value, std::size_t count);
 
-    void setVec3Array(const std::string &name, const std::vector<glm::vec3> &values);
+    void setVec3Array(std::string_view name, const std::vector<glm::vec3> &values);
 
     template<typename T>
-    auto getUniform(const std::string &name) const -> T;
+    auto getUniform(std::string_view name) const -> T;
 
 private:
     std::filesystem::path vertexPath;
@@ -67,7 +69,16 @@ private:
     std::string tessControlCode;
     std::string tessEvalCode;
 
-    std::unordered_map<std::string, GLint> uniformLocations;
+    // looked up by string_view, so setting a uniform by name doesn't build a string every call
+    struct NameHash {
+        using is_transparent = void;
+
+        auto operator()(const std::string_view name) const noexcept -> std::size_t {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    std::unordered_map<std::string, GLint, NameHash, std::equal_to<> > uniformLocations;
 
     GLuint ID = 0;
 
@@ -11,13 +11,173 @@
 #include "graphics/stb_image.h"
 
 #include <GL/glew.h>
+#include <cstdint>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <optional>
 #include <print>
 #include <span>
 #include <string>
+#include <system_error>
+#include <vector>
+
+#include "graphics/GpuMemory.h"
+#include "graphics/TextureContainer.h"
+
+namespace {
+    // mirrors stb's global flag, baked files only match when they were flipped the same way
+    bool flipped = false;
+
+    auto GetBlockFormat(const Texture::Container::Encoding encoding) -> GLenum {
+        return encoding == Texture::Container::Encoding::BC1
+                   ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+                   : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    }
+
+    auto DecodeBaked(const std::filesystem::path &source, Texture::Loader::Image &image) -> bool {
+        using namespace Texture::Container;
+
+        const auto path = bakedPath(source);
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        std::error_code error;
+        const auto fileSize = static_cast<std::size_t>(std::filesystem::file_size(path, error));
+        if (error) {
+            return false;
+        }
+
+        Header header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(Header));
+
+        if (!file || header.magic != MAGIC || header.version != VERSION ||
+            header.flipped != static_cast<std::uint32_t>(flipped) || header.levels == 0) {
+            return false;
+        }
+
+        // every count and offset is checked against the file before anything is sized from it
+        if (header.levels > (fileSize - sizeof(Header)) / sizeof(Level)) {
+            std::println(stderr, "Baked texture {} is truncated", path.string());
+            return false;
+        }
+
+        std::vector<Level> levels(header.levels);
+        file.read(reinterpret_cast<char *>(levels.data()), static_cast<std::streamsize>(levels.size() * sizeof(Level)));
+
+        const std::size_t available = fileSize - sizeof(Header) - levels.size() * sizeof(Level);
+        const auto end = file ? extent(header, levels, available) : std::nullopt;
+
+        if (!end.has_value()) {
+            std::println(stderr, "Baked texture {} is truncated or corrupt", path.string());
+            return false;
+        }
+
+        const auto size = static_cast<std::size_t>(*end);
+
+        // malloc so the stb deleter can free it like any other image
+        image.pixels.reset(static_cast<unsigned char *>(std::malloc(size)));
+        if (image.pixels == nullptr) {
+            std::println(stderr, "Could not allocate {} bytes for baked texture {}", size, path.string());
+            return false;
+        }
+
+        file.read(reinterpret_cast<char *>(image.pixels.get()), static_cast<std::streamsize>(size));
+
+        if (!file) {
+            std::println(stderr, "Baked texture {} is truncated", path.string());
+            image.pixels.reset();
+            return false;
+        }
+
+        image.width = static_cast<int>(header.width);
+        image.height = static_cast<int>(header.height);
+        image.channels = channels(header.encoding);
+        image.compressed = isCompressed(header.encoding) ? GetBlockFormat(header.encoding) : 0;
+        image.size = size;
+
+        for (const auto &[width, height, offset, levelSize]: levels) {
+            image.levels.push_back({
+                static_cast<GLsizei>(width), static_cast<GLsizei>(height), static_cast<std::size_t>(offset),
+                static_cast<std::size_t>(levelSize)
+            });
+        }
+
+        return true;
+    }
+}
 
 namespace Texture::Loader {
+    void ImageDeleter::operator()(unsigned char *pixels) const {
+        stbi_image_free(pixels);
+    }
+
+    auto decode(const std::filesystem::path &path) -> Image {
+        Image image;
+
+        if (Container::isCurrent(path) && DecodeBaked(path, image)) {
+            return image;
+        }
+
+        image.pixels.reset(stbi_load(path.c_str(), &image.width, &image.height, &image.channels, 0));
+
+        if (image.pixels == nullptr) {
+            std::println(stderr, "Failed to load texture: {} - {}", path.c_str(), stbi_failure_reason());
+            return image;
+        }
+
+        image.size = static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height) *
+                     static_cast<std::size_t>(image.channels);
+
+        return image;
+    }
+
+    auto upload(const Image &image, const unsigned char *pixels) -> bool {
+        if (image.compressed != 0 && GLEW_EXT_texture_compression_s3tc == 0U) {
+            std::println(stderr, "Baked texture is block compressed, but S3TC isn't supported");
+            return false;
+        }
+
+        const GLint format = getFormat(image.channels);
+
+        // rows of 1 and 3 channel images aren't 4 byte aligned
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        if (image.levels.empty()) {
+            glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, pixels);
+            glGenerateMipmap(GL_TEXTURE_2D);
+        } else {
+            for (std::size_t i = 0; i < image.levels.size(); i++) {
+                const auto &[width, height, offset, size] = image.levels[i];
+                const auto level = static_cast<GLint>(i);
+
+                if (image.compressed != 0) {
+                    glCompressedTexImage2D(GL_TEXTURE_2D, level, image.compressed, width, height, 0,
+                                           static_cast<GLsizei>(size), pixels + offset);
+                } else {
+                    glTexImage2D(GL_TEXTURE_2D, level, format, width, height, 0, format, GL_UNSIGNED_BYTE,
+                                 pixels + offset);
+                }
+            }
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size()) - 1);
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        return true;
+    }
+
+    auto residentBytes(const Image &image) -> std::size_t {
+        // baked chains are stored exactly as they sit in memory, a generated chain adds about a third
+        return image.levels.empty() ? image.size + image.size / 3 : image.size;
+    }
+
     auto
     load(const std::string &filename, const std::filesystem::path &directory, const GLint wrapS, const GLint wrapT,
          const GLint minFilter, const GLint magFilter) -> GLuint {
@@ -29,28 +189,18 @@ namespace Texture::Loader {
         GLuint texture;
         glGenTextures(1, &texture);
 
-        int width;
-        int height;
-        int nrChannels;
-
-        unsigned char *data = stbi_load(path.c_str(), &width, &height, &nrChannels, 0);
-        if (data != nullptr) {
-            const GLint format = getFormat(nrChannels);
-
-            glBindTexture(GL_TEXTURE_2D, texture);
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
+        const Image image = decode(path);
+        glBindTexture(GL_TEXTURE_2D, texture);
 
+        if (image.pixels != nullptr && upload(image, image.pixels.get())) {
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
-        } else {
-            const char *failureReason = stbi_failure_reason();
-            std::println(stderr, "Failed to load texture: {} - {}", path.c_str(), failureReason);
-        }
 
-        stbi_image_free(data);
+            GpuMemory::Track(GpuMemory::Object::TEXTURE, texture, GpuMemory::Category::TEXTURES,
+                             residentBytes(image), "Texture loader");
+        }
 
         return texture;
     }
@@ -74,6 +224,10 @@ namespace Texture::Loader {
                              GL_UNSIGNED_BYTE, data);
             }
 
+            GpuMemory::Track(GpuMemory::Object::TEXTURE, texture, GpuMemory::Category::TEXTURES,
+                             GpuMemory::ImageBytes(static_cast<GLenum>(format), width, height, CUBE_MAP_FACES),
+                             "Cube maps");
+
             /*
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
             glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
@@ -106,6 +260,7 @@ namespace Texture::Loader {
         int width;
         int height;
         int nrChannels;
+        std::size_t bytes = 0;
 
         for (std::size_t i = 0; i < faces.size(); i++) {
             stbi_uc *data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
@@ -114,6 +269,7 @@ namespace Texture::Loader {
 
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, width, height, 0, format,
                              GL_UNSIGNED_BYTE, data);
+                bytes += GpuMemory::ImageBytes(static_cast<GLenum>(format), width, height);
             } else {
                 const char *failureReason = stbi_failure_reason();
                 std::println(stderr, "Failed to load texture: {}", failureReason);
@@ -127,10 +283,13 @@ namespace Texture::Loader {
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
+        GpuMemory::Track(GpuMemory::Object::TEXTURE, texture, GpuMemory::Category::TEXTURES, bytes, "Cube maps");
+
         return texture;
     }
 
     void setFlip(const bool flip) {
+        flipped = flip;
         stbi_set_flip_vertically_on_load(static_cast<int>(flip));
     }
 }
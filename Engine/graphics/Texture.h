@@ -6,15 +6,52 @@
 #define CW_TEXTURE_H
 
 #include <GL/glew.h>
+#include <cstddef>
 #include <filesystem>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace Texture {
     namespace Loader {
         constexpr auto CUBE_MAP_FACES = 6U;
 
+        struct ImageDeleter {
+            void operator()(unsigned char *pixels) const;
+        };
+
+        struct Level {
+            GLsizei width = 0;
+            GLsizei height = 0;
+            std::size_t offset = 0;
+            std::size_t size = 0;
+        };
+
+        // decoded pixels, not yet on the gpu
+        struct Image {
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            // block format of a compressed baked file, 0 for plain pixels
+            GLenum compressed = 0;
+            // a baked file's mip chain, empty when the chain is generated on upload
+            std::vector<Level> levels;
+            std::size_t size = 0;
+            std::unique_ptr<unsigned char, ImageDeleter> pixels;
+        };
+
+        // prefers a current baked file beside the source. only touches the disk and stb, so it can run
+        // off the gl thread
+        auto decode(const std::filesystem::path &path) -> Image;
+
+        // into the bound GL_TEXTURE_2D. pixels is the image data, or an offset into the bound unpack buffer
+        auto upload(const Image &image, const unsigned char *pixels) -> bool;
+
+        // gpu bytes the image takes once uploaded, mips included
+        [[nodiscard]] auto residentBytes(const Image &image) -> std::size_t;
+
         auto load(const std::filesystem::path &path, GLint wrapS = GL_REPEAT, GLint wrapT = GL_REPEAT,
                   GLint minFilter = GL_LINEAR_MIPMAP_LINEAR, GLint magFilter = GL_LINEAR) -> GLuint;
 
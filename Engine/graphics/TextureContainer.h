@@ -0,0 +1,137 @@
+//
+// Created by Jacob Edwards on 19/05/2024.
+//
+
+#ifndef CW_TEXTURECONTAINER_H
+#define CW_TEXTURECONTAINER_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <system_error>
+
+// the baked texture format written by the asset baker. a header, one record per mip level, then the
+// level data back to back. shared with the loader, so nothing in here can depend on gl
+namespace Texture::Container {
+    constexpr std::array<char, 4> MAGIC = {'C', 'W', 'T', 'X'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr auto EXTENSION = ".ctex";
+
+    // past anything gl will take, and small enough that a level's byte count can't overflow
+    constexpr std::uint32_t MAX_DIMENSION = 1U << 16U;
+
+    enum class Encoding : std::uint32_t {
+        R8,
+        RG8,
+        RGB8,
+        RGBA8,
+        // 4x4 blocks, 8 bytes each, rgb only
+        BC1,
+        // 4x4 blocks, 16 bytes each, bc1 colour plus interpolated alpha
+        BC3,
+    };
+
+    struct Header {
+        std::array<char, 4> magic = MAGIC;
+        std::uint32_t version = VERSION;
+        Encoding encoding = Encoding::RGBA8;
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint32_t levels = 0;
+        // baked with stb's vertical flip, the loader skips files that don't match its own setting
+        std::uint32_t flipped = 0;
+        std::uint32_t padding = 0;
+    };
+
+    struct Level {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        // from the start of the level data, not the file
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    constexpr auto channels(const Encoding encoding) -> int {
+        switch (encoding) {
+            case Encoding::R8:
+                return 1;
+            case Encoding::RG8:
+                return 2;
+            case Encoding::RGB8:
+            case Encoding::BC1:
+                return 3;
+            default:
+                return 4;
+        }
+    }
+
+    constexpr auto isCompressed(const Encoding encoding) -> bool {
+        return encoding == Encoding::BC1 || encoding == Encoding::BC3;
+    }
+
+    // what one level of this size takes, a partial 4x4 block at the edge is still a whole block
+    constexpr auto levelBytes(const Encoding encoding, const std::uint32_t width, const std::uint32_t height)
+        -> std::uint64_t {
+        if (isCompressed(encoding)) {
+            const std::uint64_t blocks = (static_cast<std::uint64_t>(width) + 3U) / 4U *
+                                         ((static_cast<std::uint64_t>(height) + 3U) / 4U);
+            return blocks * (encoding == Encoding::BC1 ? 8U : 16U);
+        }
+
+        return static_cast<std::uint64_t>(width) * height * static_cast<std::uint64_t>(channels(encoding));
+    }
+
+    // the bytes of level data the levels cover, nothing when a level is the wrong size for its dimensions
+    // or reaches past what is available. levels can come in any order, so the end is the furthest of them
+    inline auto extent(const Header &header, const std::span<const Level> levels,
+                       const std::uint64_t available) -> std::optional<std::uint64_t> {
+        if (header.encoding > Encoding::BC3 || levels.empty() || levels.front().width != header.width ||
+            levels.front().height != header.height) {
+            return std::nullopt;
+        }
+
+        std::uint64_t end = 0;
+
+        for (const auto &[width, height, offset, size]: levels) {
+            if (width == 0 || height == 0 || width > MAX_DIMENSION || height > MAX_DIMENSION ||
+                size != levelBytes(header.encoding, width, height) || size > available ||
+                offset > available - size) {
+                return std::nullopt;
+            }
+
+            end = std::max(end, offset + size);
+        }
+
+        return end;
+    }
+
+    // baked files sit beside their source with the extension swapped
+    inline auto bakedPath(const std::filesystem::path &source) -> std::filesystem::path {
+        auto baked = source;
+        baked.replace_extension(EXTENSION);
+        return baked;
+    }
+
+    // present and at least as new as the source
+    inline auto isCurrent(const std::filesystem::path &source) -> bool {
+        std::error_code error;
+        const auto baked = bakedPath(source);
+
+        if (!std::filesystem::exists(baked, error)) {
+            return false;
+        }
+
+        const auto bakedTime = std::filesystem::last_write_time(baked, error);
+        if (error) {
+            return false;
+        }
+
+        const auto sourceTime = std::filesystem::last_write_time(source, error);
+        return error || bakedTime >= sourceTime;
+    }
+}
+
+#endif //CW_TEXTURECONTAINER_H
@@ -7,6 +7,8 @@
 #include <cstdio>
 #include <print>
 
+#include "graphics/GpuMemory.h"
+
 DepthBuffer::DepthBuffer(const unsigned int width, const unsigned int height) {
     glGenFramebuffers(1, &DBO);
     glBindFramebuffer(GL_FRAMEBUFFER, DBO);
@@ -31,6 +33,12 @@ DepthBuffer::DepthBuffer(const unsigned int width, const unsigned int height) {
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+    const auto bytes = GpuMemory::ImageBytes(GL_DEPTH_COMPONENT32F, static_cast<GLsizei>(width),
+                                             static_cast<GLsizei>(height));
+    GpuMemory::Track(GpuMemory::Object::RENDERBUFFER, RBO, GpuMemory::Category::RENDER_TARGETS, bytes, "Depth buffer");
+    GpuMemory::Track(GpuMemory::Object::TEXTURE, texture.id, GpuMemory::Category::RENDER_TARGETS, bytes,
+                     "Depth buffer");
+
     this->width = width;
     this->height = height;
 }
@@ -65,8 +73,12 @@ void DepthBuffer::Clear() {
 }
 
 void DepthBuffer::destroy() const {
+    GpuMemory::Release(GpuMemory::Object::RENDERBUFFER, RBO);
+    GpuMemory::Release(GpuMemory::Object::TEXTURE, texture.id);
+
     glDeleteFramebuffers(1, &DBO);
     glDeleteRenderbuffers(1, &RBO);
+    glDeleteTextures(1, &texture.id);
 }
 
 [[nodiscard]] auto DepthBuffer::getDBO() const -> GLuint {
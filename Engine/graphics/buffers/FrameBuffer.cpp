@@ -8,6 +8,8 @@
 #include <iostream>
 #include <print>
 
+#include "graphics/GpuMemory.h"
+
 FrameBuffer::FrameBuffer(const unsigned int width,
                          const unsigned int height, const bool multisample)
     : width(width), height(height), multisample(multisample) {
@@ -15,8 +17,10 @@ FrameBuffer::FrameBuffer(const unsigned int width,
 }
 
 FrameBuffer::~FrameBuffer() {
+    release();
+
     glDeleteFramebuffers(1, &FBO);
-    glDeleteRenderbuffers(1, &RBO);
+    glDeleteTextures(1, &depthTexture.id);
     glDeleteTextures(1, &texture.id);
 
     glDeleteFramebuffers(1, &MSFBO);
@@ -27,8 +31,8 @@ FrameBuffer::~FrameBuffer() {
 
 FrameBuffer::FrameBuffer(FrameBuffer &&other) noexcept {
     FBO = other.FBO;
-    RBO = other.RBO;
     texture = other.texture;
+    depthTexture = other.depthTexture;
     MSFBO = other.MSFBO;
     MSRBO = other.MSRBO;
     MSRBO_depth = other.MSRBO_depth;
@@ -38,8 +42,8 @@ FrameBuffer::FrameBuffer(FrameBuffer &&other) noexcept {
     multisample = other.multisample;
 
     other.FBO = 0;
-    other.RBO = 0;
     other.texture.id = 0;
+    other.depthTexture.id = 0;
     other.MSFBO = 0;
     other.MSRBO = 0;
     other.MSRBO_depth = 0;
@@ -51,16 +55,18 @@ FrameBuffer::FrameBuffer(FrameBuffer &&other) noexcept {
 
 auto FrameBuffer::operator=(FrameBuffer &&other) noexcept -> FrameBuffer & {
     if (this != &other) {
+        release();
+
         glDeleteFramebuffers(1, &FBO);
-        glDeleteRenderbuffers(1, &RBO);
+        glDeleteTextures(1, &depthTexture.id);
         glDeleteTextures(1, &texture.id);
         glDeleteFramebuffers(1, &MSFBO);
         glDeleteRenderbuffers(1, &MSRBO);
         glDeleteRenderbuffers(1, &MSRBO_depth);
 
         FBO = other.FBO;
-        RBO = other.RBO;
         texture = other.texture;
+        depthTexture = other.depthTexture;
         MSFBO = other.MSFBO;
         MSRBO = other.MSRBO;
         MSRBO_depth = other.MSRBO_depth;
@@ -70,8 +76,8 @@ auto FrameBuffer::operator=(FrameBuffer &&other) noexcept -> FrameBuffer & {
         multisample = other.multisample;
 
         other.FBO = 0;
-        other.RBO = 0;
         other.texture.id = 0;
+        other.depthTexture.id = 0;
         other.MSFBO = 0;
         other.MSRBO = 0;
         other.MSRBO_depth = 0;
@@ -109,6 +115,10 @@ void FrameBuffer::unbind() const {
         glBlitFramebuffer(0, 0, static_cast<GLint>(width), static_cast<GLint>(height), 0, 0,
                           static_cast<GLint>(width), static_cast<GLint>(height),
                           GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        // resolve depth as well so post processing can sample it
+        glBlitFramebuffer(0, 0, static_cast<GLint>(width), static_cast<GLint>(height), 0, 0,
+                          static_cast<GLint>(width), static_cast<GLint>(height),
+                          GL_DEPTH_BUFFER_BIT, GL_NEAREST);
     }
     glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
 
@@ -137,12 +147,17 @@ void FrameBuffer::setup() {
     glGenFramebuffers(1, &FBO);
     glBindFramebuffer(GL_FRAMEBUFFER, FBO);
 
-    glGenRenderbuffers(1, &RBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, RBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, static_cast<GLsizei>(width),
-                          static_cast<GLsizei>(height));
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
-                              GL_RENDERBUFFER, RBO);
+    // sampleable depth, written directly or resolved into from the multisampled buffer
+    glGenTextures(1, &depthTexture.id);
+    glBindTexture(GL_TEXTURE_2D, depthTexture.id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+                 GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D,
+                           depthTexture.id, 0);
 
     // color texture
     glGenTextures(1, &texture.id);
@@ -165,14 +180,14 @@ void FrameBuffer::setup() {
 
     glGenRenderbuffers(1, &MSRBO);
     glBindRenderbuffer(GL_RENDERBUFFER, MSRBO);
-    glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGBA8, static_cast<GLsizei>(width),
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, SAMPLES, GL_RGBA8, static_cast<GLsizei>(width),
                                      static_cast<GLsizei>(height));
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
                               GL_RENDERBUFFER, MSRBO);
 
     glGenRenderbuffers(1, &MSRBO_depth);
     glBindRenderbuffer(GL_RENDERBUFFER, MSRBO_depth);
-    glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_DEPTH24_STENCIL8,
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, SAMPLES, GL_DEPTH24_STENCIL8,
                                      static_cast<GLsizei>(width), static_cast<GLsizei>(height));
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
                               GL_RENDERBUFFER, MSRBO_depth);
@@ -183,44 +198,67 @@ void FrameBuffer::setup() {
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    glGenTextures(1, &depthTexture.id);
-    glBindTexture(GL_TEXTURE_2D, depthTexture.id);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
-                 GL_DEPTH_COMPONENT,
-                 GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D,
-                           depthTexture.id, 0);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        std::println(stderr, "Framebuffer is not complete!");
-    }
+    track();
+    trackMultisampled();
 }
 
 void FrameBuffer::resize() const {
     if (multisample) {
         glBindFramebuffer(GL_FRAMEBUFFER, MSFBO);
         glBindRenderbuffer(GL_RENDERBUFFER, MSRBO);
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGBA8, static_cast<GLsizei>(width),
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, SAMPLES, GL_RGBA8, static_cast<GLsizei>(width),
                                          static_cast<GLsizei>(height));
         glBindRenderbuffer(GL_RENDERBUFFER, MSRBO_depth);
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_DEPTH24_STENCIL8,
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, SAMPLES, GL_DEPTH24_STENCIL8,
                                          static_cast<GLsizei>(width), static_cast<GLsizei>(height));
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        trackMultisampled();
     }
 
-    glBindRenderbuffer(GL_RENDERBUFFER, RBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, static_cast<GLsizei>(width),
-                          static_cast<GLsizei>(height));
     glBindTexture(GL_TEXTURE_2D, texture.id);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0, GL_RGB,
                  GL_UNSIGNED_BYTE, nullptr);
 
     glBindTexture(GL_TEXTURE_2D, depthTexture.id);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
-                 GL_DEPTH_COMPONENT,
-                 GL_FLOAT, nullptr);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+                 GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+
+    track();
+}
+
+void FrameBuffer::track() const {
+    using GpuMemory::Category;
+    using GpuMemory::Object;
+
+    const auto w = static_cast<GLsizei>(width);
+    const auto h = static_cast<GLsizei>(height);
+
+    GpuMemory::Track(Object::TEXTURE, texture.id, Category::RENDER_TARGETS, GpuMemory::ImageBytes(GL_RGB, w, h),
+                     "Frame buffer");
+    GpuMemory::Track(Object::TEXTURE, depthTexture.id, Category::RENDER_TARGETS,
+                     GpuMemory::ImageBytes(GL_DEPTH24_STENCIL8, w, h), "Frame buffer");
+}
+
+void FrameBuffer::trackMultisampled() const {
+    using GpuMemory::Category;
+    using GpuMemory::Object;
+
+    const auto w = static_cast<GLsizei>(width);
+    const auto h = static_cast<GLsizei>(height);
+
+    // allocated even while multisampling is off, it just keeps whatever size it last had
+    GpuMemory::Track(Object::RENDERBUFFER, MSRBO, Category::RENDER_TARGETS,
+                     GpuMemory::ImageBytes(GL_RGBA8, w, h, 1, SAMPLES), "Frame buffer (multisampled)");
+    GpuMemory::Track(Object::RENDERBUFFER, MSRBO_depth, Category::RENDER_TARGETS,
+                     GpuMemory::ImageBytes(GL_DEPTH24_STENCIL8, w, h, 1, SAMPLES), "Frame buffer (multisampled)");
+}
+
+void FrameBuffer::release() const {
+    GpuMemory::Release(GpuMemory::Object::TEXTURE, texture.id);
+    GpuMemory::Release(GpuMemory::Object::TEXTURE, depthTexture.id);
+    GpuMemory::Release(GpuMemory::Object::RENDERBUFFER, MSRBO);
+    GpuMemory::Release(GpuMemory::Object::RENDERBUFFER, MSRBO_depth);
 }
 
 void FrameBuffer::setMultisampled(const bool multisampled) {
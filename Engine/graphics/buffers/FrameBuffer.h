@@ -41,9 +41,17 @@ protected:
 
     void resize() const;
 
+    // file the attachments with GpuMemory at the current size
+    void track() const;
+
+    void trackMultisampled() const;
+
+    void release() const;
+
 private:
+    static constexpr GLsizei SAMPLES = 4;
+
     GLuint FBO = 0;
-    GLuint RBO = 0;
     Texture::Data texture;
     Texture::Data depthTexture;
 
@@ -4,44 +4,91 @@
 
 #include "graphics/buffers/ShadowBuffer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <array>
+#include <limits>
 #include <print>
+#include <string_view>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
 
-ShadowBuffer::ShadowBuffer(const unsigned int width, const unsigned int height) {
-    glGenFramebuffers(1, &FBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+#include "graphics/GpuMemory.h"
+#include "graphics/GpuProfiler.h"
+#include "imgui/imgui.h"
+#include "utils/BoundingBox.h"
+#include "utils/Camera.h"
 
-    glGenTextures(1, &depthTexture);
-    glBindTexture(GL_TEXTURE_2D, depthTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
-                 GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    constexpr std::array<GLfloat, 4> borderColor{1.0, 1.0, 1.0, 1.0};
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor.data());
+ShadowBuffer::ShadowBuffer(const unsigned int size) : size(size) {
+    createTexture(depthTexture, FBO, "Shadow map");
+    createTexture(staticTexture, staticFBO, "Shadow cache");
 
-    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    invalidate();
+}
 
-    glDrawBuffer(GL_NONE);
-    glReadBuffer(GL_NONE);
+ShadowBuffer::~ShadowBuffer() {
+    destroy();
+}
 
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        std::println(stderr, "Framebuffer is not complete!");
+void ShadowBuffer::update(const Camera &camera, const glm::vec3 &lightDirection) {
+    const auto splits = camera.getCascadeSplits<SHADOW_CASCADES>(splitLambda, shadowDistance);
+    const auto direction = glm::normalize(lightDirection);
+
+    if (glm::dot(direction, fitDirection) < std::cos(glm::radians(sunThreshold))) {
+        fitDirection = direction;
+        invalidate();
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    for (unsigned int i = 0; i < SHADOW_CASCADES; i++) {
+        const auto corners = camera.getFrustumCorners(splits[i], splits[i + 1]);
+
+        auto centre = glm::vec3(0.0F);
+        std::ranges::for_each(corners, [&centre](const auto &corner) { centre += corner; });
+        centre /= static_cast<float>(corners.size());
+
+        // a bounding sphere keeps the cascade the same size as the camera turns
+        float radius = 0.0F;
+        std::ranges::for_each(corners, [&](const auto &corner) {
+            radius = std::max(radius, glm::length(corner - centre));
+        });
+        radius = std::ceil(radius * 16.0F) / 16.0F;
+
+        const bool outside = glm::length(centre - fitCentres[i]) + radius > fitRadii[i];
+
+        if (staticDirty[i] || outside || radius * fitPadding < fitRadii[i] * 0.5F) {
+            fit(i, centre, radius * fitPadding);
+        }
 
-    this->width = width;
-    this->height = height;
+        cascades.splits[static_cast<int>(i)] = splits[i + 1];
+    }
 }
 
-ShadowBuffer::~ShadowBuffer() {
-    destroy();
+void ShadowBuffer::fit(const unsigned int cascade, const glm::vec3 &centre, const float radius) {
+    const auto up = std::abs(fitDirection.y) > 0.99F ? glm::vec3(0.0F, 0.0F, 1.0F) : glm::vec3(0.0F, 1.0F, 0.0F);
+
+    const auto lightView = glm::lookAt(centre + fitDirection * (radius + casterDistance), centre, up);
+    auto lightProjection = glm::ortho(-radius, radius, -radius, radius, 0.0F, 2.0F * radius + casterDistance);
+
+    // snap the origin to whole texels to stop the edges shimmering between refits
+    const auto halfSize = static_cast<float>(size) / 2.0F;
+    const auto origin = lightProjection * lightView * glm::vec4(0.0F, 0.0F, 0.0F, 1.0F) * halfSize;
+    const auto offset = (glm::round(origin) - origin) / halfSize;
+    lightProjection[3][0] += offset.x;
+    lightProjection[3][1] += offset.y;
+
+    fitCentres[cascade] = centre;
+    fitRadii[cascade] = radius;
+
+    lightViews[cascade] = lightView;
+    lightProjections[cascade] = lightProjection;
+    cascades.lightSpaceMatrices[cascade] = lightProjection * lightView;
+
+    staticDirty[cascade] = true;
+    refits[cascade]++;
 }
 
 void ShadowBuffer::bind() {
@@ -50,30 +97,164 @@ void ShadowBuffer::bind() {
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, reinterpret_cast<GLint *>(&previousFBO));
     glGetIntegerv(GL_VIEWPORT, previousViewport.data());
 
-    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
-    glViewport(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
-    glClear(GL_DEPTH_BUFFER_BIT);
+    glViewport(0, 0, static_cast<GLsizei>(size), static_cast<GLsizei>(size));
 
     glCullFace(GL_BACK);
     glDepthFunc(GL_LESS);
 }
 
-void ShadowBuffer::unbind() const {
+auto ShadowBuffer::bindStatic(const unsigned int cascade) -> bool {
+    if (!caching || !staticDirty[cascade]) {
+        return false;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, staticFBO);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, staticTexture, 0, static_cast<GLint>(cascade));
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    staticDirty[cascade] = false;
+
+    return true;
+}
+
+void ShadowBuffer::bindCascade(const unsigned int cascade) const {
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0, static_cast<GLint>(cascade));
+
+    if (!caching) {
+        glClear(GL_DEPTH_BUFFER_BIT);
+        return;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, staticFBO);
+    glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, staticTexture, 0,
+                              static_cast<GLint>(cascade));
+
+    const auto extent = static_cast<GLint>(size);
+    glBlitFramebuffer(0, 0, extent, extent, 0, 0, extent, extent, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+}
+
+void ShadowBuffer::unbind() {
     glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
     glCullFace(previousCullFace);
     glDepthFunc(previousDepthFunc);
     glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
 }
 
+void ShadowBuffer::invalidate() {
+    staticDirty.fill(true);
+}
+
+[[nodiscard]] auto ShadowBuffer::isCaching() const -> bool {
+    return caching;
+}
+
+[[nodiscard]] auto ShadowBuffer::getPassName() const -> const char * {
+    return caching ? CACHED_PASS : UNCACHED_PASS;
+}
+
 void ShadowBuffer::Clear() {
     glClear(GL_DEPTH_BUFFER_BIT);
 }
 
 void ShadowBuffer::destroy() const {
+    GpuMemory::Release(GpuMemory::Object::TEXTURE, depthTexture);
+    GpuMemory::Release(GpuMemory::Object::TEXTURE, staticTexture);
+
     glDeleteFramebuffers(1, &FBO);
     glDeleteTextures(1, &depthTexture);
+
+    glDeleteFramebuffers(1, &staticFBO);
+    glDeleteTextures(1, &staticTexture);
+}
+
+void ShadowBuffer::createTexture(GLuint &texture, GLuint &fbo, const std::string_view owner) const {
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, static_cast<GLsizei>(size),
+                 static_cast<GLsizei>(size), SHADOW_CASCADES, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    GpuMemory::Track(GpuMemory::Object::TEXTURE, texture, GpuMemory::Category::SHADOWS,
+                     GpuMemory::ImageBytes(GL_DEPTH_COMPONENT32F, static_cast<GLsizei>(size),
+                                           static_cast<GLsizei>(size), SHADOW_CASCADES), owner);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    constexpr std::array<GLfloat, 4> borderColor{1.0, 1.0, 1.0, 1.0};
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor.data());
+
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, 0);
+
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::println(stderr, "Framebuffer is not complete!");
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 [[nodiscard]] auto ShadowBuffer::getTexture() const -> GLuint {
     return depthTexture;
 }
+
+[[nodiscard]] auto ShadowBuffer::getCascades() const -> const Cascades & {
+    return cascades;
+}
+
+[[nodiscard]] auto ShadowBuffer::getLightView(const unsigned int cascade) const -> const glm::mat4 & {
+    return lightViews[cascade];
+}
+
+[[nodiscard]] auto ShadowBuffer::getLightProjection(const unsigned int cascade) const -> const glm::mat4 & {
+    return lightProjections[cascade];
+}
+
+[[nodiscard]] auto ShadowBuffer::isVisible(const unsigned int cascade, const BoundingBox &box) const -> bool {
+    auto min = glm::vec3(std::numeric_limits<float>::max());
+    auto max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    for (const auto &corner: box.getCorners()) {
+        const auto lightSpace = glm::vec3(cascades.lightSpaceMatrices[cascade] * glm::vec4(corner, 1.0F));
+        min = glm::min(min, lightSpace);
+        max = glm::max(max, lightSpace);
+    }
+
+    // anything between the light and the cascade still casts into it, so only the far plane culls in z
+    return max.x >= -1.0F && min.x <= 1.0F && max.y >= -1.0F && min.y <= 1.0F && min.z <= 1.0F;
+}
+
+void ShadowBuffer::interface() {
+    ImGui::Begin("Shadow Buffer");
+    ImGui::SliderFloat("Split Lambda", &splitLambda, 0.0F, 1.0F);
+    ImGui::SliderFloat("Shadow Distance", &shadowDistance, 10.0F, 1000.0F);
+    ImGui::SliderFloat("Caster Distance", &casterDistance, 0.0F, 1000.0F);
+    ImGui::SliderFloat("Fit Padding", &fitPadding, 1.0F, 2.0F);
+    ImGui::SliderFloat("Sun Threshold", &sunThreshold, 0.0F, 10.0F);
+
+    if (ImGui::Checkbox("Cache Static Casters", &caching)) {
+        invalidate();
+    }
+
+    if (ImGui::Button("Invalidate")) {
+        invalidate();
+    }
+
+    for (unsigned int i = 0; i < SHADOW_CASCADES; i++) {
+        ImGui::Text("Cascade %u: %.1f, %u refits", i, cascades.splits[static_cast<int>(i)], refits[i]);
+    }
+
+    const auto &gpuProfiler = GpuProfiler::GetInstance();
+    ImGui::Text("Shadow Pass (cached): %.3f ms", gpuProfiler.getGpuStats(CACHED_PASS).average);
+    ImGui::Text("Shadow Pass (uncached): %.3f ms", gpuProfiler.getGpuStats(UNCACHED_PASS).average);
+
+    ImGui::Text("Memory: %.1f MB", 2.0F * static_cast<float>(size) * static_cast<float>(size) * SHADOW_CASCADES *
+                                   4.0F / (1024.0F * 1024.0F));
+    ImGui::End();
+}
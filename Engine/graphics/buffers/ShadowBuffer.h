@@ -3,6 +3,7 @@
 //
 /*
  * https://learnopengl.com/Advanced-Lighting/Shadows/Shadow-Mapping
+ * https://learnopengl.com/Guest-Articles/2021/CSM
  */
 
 #ifndef CW_SHADOWBUFFER_H
@@ -10,10 +11,30 @@
 
 #include <GL/glew.h>
 #include <array>
+#include <cstddef>
+#include <string_view>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+
+#include "utils/BoundingBox.h"
+#include "utils/Camera.h"
+
+constexpr unsigned int SHADOW_CASCADES = 4;
+
+// binding point of the Shadows uniform block in shadows.glsl
+constexpr unsigned int SHADOWS_BINDING = 3;
 
 class ShadowBuffer {
 public:
-    ShadowBuffer(unsigned int width, unsigned int height);
+    // uploaded as-is to the std140 Shadows block in shadows.glsl
+    struct Cascades {
+        std::array<glm::mat4, SHADOW_CASCADES> lightSpaceMatrices;
+        // far view depth of each cascade
+        glm::vec4 splits;
+    };
+
+    explicit ShadowBuffer(unsigned int size);
 
     ~ShadowBuffer();
 
@@ -21,9 +42,27 @@ public:
 
     auto operator=(const ShadowBuffer &) -> ShadowBuffer & = delete;
 
+    // fits each cascade to its slice of the camera frustum, lightDirection points towards the light.
+    // cascades are padded and only refit once the camera leaves them so the static cache stays valid
+    void update(const Camera &camera, const glm::vec3 &lightDirection);
+
     void bind();
 
-    void unbind() const;
+    // binds the static cache layer if it needs redrawing, returns false if it is still valid
+    [[nodiscard]] auto bindStatic(unsigned int cascade) -> bool;
+
+    // binds the live layer, starting from the static cache when caching
+    void bindCascade(unsigned int cascade) const;
+
+    void unbind();
+
+    // forces the static casters to be redrawn next frame
+    void invalidate();
+
+    [[nodiscard]] auto isCaching() const -> bool;
+
+    // what the gpu profiler files the shadow pass under
+    [[nodiscard]] auto getPassName() const -> const char *;
 
     static void Clear();
 
@@ -31,20 +70,67 @@ public:
 
     [[nodiscard]] auto getTexture() const -> GLuint;
 
+    [[nodiscard]] auto getCascades() const -> const Cascades &;
+
+    [[nodiscard]] auto getLightView(unsigned int cascade) const -> const glm::mat4 &;
+
+    [[nodiscard]] auto getLightProjection(unsigned int cascade) const -> const glm::mat4 &;
+
+    // whether a world space box can cast a shadow into the cascade
+    [[nodiscard]] auto isVisible(unsigned int cascade, const BoundingBox &box) const -> bool;
+
+    void interface();
+
 private:
     GLuint depthTexture = 0;
     GLuint FBO = 0;
     GLuint previousFBO = 0;
 
+    GLuint staticTexture = 0;
+    GLuint staticFBO = 0;
+
     GLenum previousCullFace = GL_BACK;
     GLenum previousDepthFunc = GL_LESS;
 
     // previous viewport
     std::array<GLint, 4> previousViewport{};
 
-    unsigned int width;
-    unsigned int height;
+    unsigned int size;
+
+    Cascades cascades{};
+    std::array<glm::mat4, SHADOW_CASCADES> lightViews{};
+    std::array<glm::mat4, SHADOW_CASCADES> lightProjections{};
+
+    float splitLambda = 0.8F;
+    float shadowDistance = 400.0F;
+    // how far behind each cascade casters are still picked up
+    float casterDistance = 200.0F;
+
+    bool caching = true;
+    std::array<bool, SHADOW_CASCADES> staticDirty{};
+    std::array<glm::vec3, SHADOW_CASCADES> fitCentres{};
+    std::array<float, SHADOW_CASCADES> fitRadii{};
+    glm::vec3 fitDirection = glm::vec3(0.0F);
+
+    // extra room around each cascade so it survives some camera movement before refitting
+    float fitPadding = 1.25F;
+    // degrees the sun can move before the cache is rebuilt
+    float sunThreshold = 0.5F;
+
+    std::array<unsigned int, SHADOW_CASCADES> refits{};
+
+    // shadow pass gpu time is kept separately for cached and uncached so the two can be compared
+    static constexpr auto CACHED_PASS = "Shadow pass (cached)";
+    static constexpr auto UNCACHED_PASS = "Shadow pass (uncached)";
+
+    void createTexture(GLuint &texture, GLuint &fbo, std::string_view owner) const;
+
+    void fit(unsigned int cascade, const glm::vec3 &centre, float radius);
 };
 
+static_assert(SHADOW_CASCADES <= 4, "cascade splits are packed into a single vec4");
+static_assert(offsetof(ShadowBuffer::Cascades, splits) == SHADOW_CASCADES * sizeof(glm::mat4));
+static_assert(sizeof(ShadowBuffer::Cascades) == SHADOW_CASCADES * sizeof(glm::mat4) + sizeof(glm::vec4));
+
 
 #endif //CW_SHADOWBUFFER_H
@@ -0,0 +1,264 @@
+//
+// Created by Jacob Edwards on 16/05/2024.
+//
+
+#include "graphics/buffers/StaticGeometry.h"
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdio>
+#include <glm/ext/matrix_float3x3.hpp>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <glm/matrix.hpp>
+#include <memory>
+#include <numeric>
+#include <print>
+#include <span>
+#include <vector>
+
+#include "Config.h"
+#include "graphics/GpuMemory.h"
+#include "graphics/Mesh.h"
+#include "graphics/Model.h"
+#include "graphics/Shader.h"
+#include "graphics/Vertex.h"
+#include "imgui/imgui.h"
+
+StaticGeometry::StaticGeometry(Token) {
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+
+    indirect = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+
+    if (indirect) {
+        glGenBuffers(1, &indirectBuffer);
+    }
+}
+
+StaticGeometry::~StaticGeometry() {
+    GpuMemory::Release(GpuMemory::Object::BUFFER, VBO);
+    GpuMemory::Release(GpuMemory::Object::BUFFER, EBO);
+    GpuMemory::Release(GpuMemory::Object::BUFFER, indirectBuffer);
+
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+    glDeleteBuffers(1, &indirectBuffer);
+}
+
+auto StaticGeometry::add(const std::span<const Vertex::Data> vertices,
+                         const std::span<const GLuint> indices) -> Range {
+    const auto base = static_cast<GLuint>(this->vertices.size());
+    const Range range{static_cast<GLuint>(this->indices.size()), static_cast<GLsizei>(indices.size())};
+
+    this->vertices.insert(this->vertices.end(), vertices.begin(), vertices.end());
+
+    // rebased here so the draws never need a base vertex, which glMultiDrawElements can't take
+    for (const auto index: indices) {
+        this->indices.push_back(base + index);
+    }
+
+    return range;
+}
+
+auto StaticGeometry::add(const Mesh &mesh, const std::span<const glm::mat4> transforms) -> Range {
+    const auto &data = mesh.getBuffer().data;
+
+    if (data.vertices.empty() && mesh.getBuffer().getVertexCount() != 0) {
+        std::println(stderr, "Can't bake a mesh that has already dropped its vertices");
+        return {static_cast<GLuint>(indices.size()), 0};
+    }
+
+    std::vector<GLuint> meshIndices = data.indices;
+    if (meshIndices.empty()) {
+        meshIndices.resize(data.vertices.size());
+        std::iota(meshIndices.begin(), meshIndices.end(), 0U);
+    }
+
+    Range range{static_cast<GLuint>(indices.size()), 0};
+    std::vector<Vertex::Data> baked(data.vertices.size());
+
+    for (const auto &transform: transforms) {
+        // the same normal matrix the shaders build from the model uniform
+        const auto normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+
+        for (std::size_t i = 0; i < data.vertices.size(); i++) {
+            baked[i] = data.vertices[i];
+            baked[i].position = glm::vec3(transform * glm::vec4(data.vertices[i].position, 1.0F));
+            baked[i].normal = normalMatrix * data.vertices[i].normal;
+            baked[i].tangent = normalMatrix * data.vertices[i].tangent;
+            baked[i].bitangent = normalMatrix * data.vertices[i].bitangent;
+        }
+
+        range.count += add(baked, meshIndices).count;
+    }
+
+    return range;
+}
+
+auto StaticGeometry::add(const Model &model, const std::span<const glm::mat4> transforms) -> std::vector<Part> {
+    std::vector<Part> parts;
+    parts.reserve(model.getMeshes().size());
+
+    for (const auto &mesh: model.getMeshes()) {
+        parts.push_back({mesh.get(), add(*mesh, transforms)});
+    }
+
+    return parts;
+}
+
+void StaticGeometry::upload() {
+    // the buffers are sized once, everything static has to be added before this
+    if (vertexCount != 0) {
+        std::println(stderr, "Static geometry has already been uploaded");
+        return;
+    }
+
+    vertexCount = vertices.size();
+    indexCount = indices.size();
+
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex::Data)),
+                 vertices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)),
+                 indices.data(), GL_STATIC_DRAW);
+
+    GpuMemory::Track(GpuMemory::Object::BUFFER, VBO, GpuMemory::Category::GEOMETRY,
+                     vertices.size() * sizeof(Vertex::Data), "Static geometry");
+    GpuMemory::Track(GpuMemory::Object::BUFFER, EBO, GpuMemory::Category::GEOMETRY, indices.size() * sizeof(GLuint),
+                     "Static geometry");
+
+    setup();
+
+    glBindVertexArray(0);
+
+    vertices = {};
+    indices = {};
+}
+
+void StaticGeometry::bind() const {
+    glBindVertexArray(VAO);
+}
+
+void StaticGeometry::unbind() const {
+    glBindVertexArray(0);
+}
+
+void StaticGeometry::draw(const std::span<const Range> ranges) const {
+    if (ranges.empty()) {
+        return;
+    }
+
+    bind();
+    multiDraw(ranges);
+    unbind();
+}
+
+void StaticGeometry::draw(const std::shared_ptr<Shader> &shader, const std::span<const Part> parts) const {
+    shader->use();
+    shader->setUniform("model", Config::IDENTITY_MATRIX);
+
+    bind();
+
+    for (const auto &[mesh, range]: parts) {
+        mesh->bindMaterial(shader);
+        glDrawElements(GL_TRIANGLES, range.count, GL_UNSIGNED_INT,
+                       reinterpret_cast<const void *>(range.first * sizeof(GLuint)));
+    }
+
+    unbind();
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void StaticGeometry::drawAll() const {
+    bind();
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, nullptr);
+    unbind();
+}
+
+void StaticGeometry::interface() const {
+    ImGui::Begin("Static Geometry");
+    ImGui::Text("Vertices: %zu", vertexCount);
+    ImGui::Text("Indices: %zu", indexCount);
+    ImGui::Text("Memory: %.1f MB", static_cast<float>(vertexCount * sizeof(Vertex::Data) +
+                                                      indexCount * sizeof(GLuint)) / (1024.0F * 1024.0F));
+    ImGui::Text("Draw Path: %s", indirect ? "glMultiDrawElementsIndirect" : "glMultiDrawElements");
+    ImGui::End();
+}
+
+void StaticGeometry::setup() const {
+    // vertex positions
+    glEnableVertexAttribArray(Vertex::Layout::POSITION);
+    glVertexAttribPointer(Vertex::Layout::POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex::Data), nullptr);
+
+    // vertex normals
+    glEnableVertexAttribArray(Vertex::Layout::NORMAL);
+    glVertexAttribPointer(Vertex::Layout::NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex::Data),
+                          reinterpret_cast<void *>(offsetof(Vertex::Data, normal)));
+
+    // vertex texture coords
+    glEnableVertexAttribArray(Vertex::Layout::TEX_COORDS);
+    glVertexAttribPointer(Vertex::Layout::TEX_COORDS, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex::Data),
+                          reinterpret_cast<void *>(offsetof(Vertex::Data, texCoords)));
+
+    // vertex tangent
+    glEnableVertexAttribArray(Vertex::Layout::TANGENT);
+    glVertexAttribPointer(Vertex::Layout::TANGENT, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex::Data),
+                          reinterpret_cast<void *>(offsetof(Vertex::Data, tangent)));
+
+    // vertex bitangent
+    glEnableVertexAttribArray(Vertex::Layout::BITANGENT);
+    glVertexAttribPointer(Vertex::Layout::BITANGENT, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex::Data),
+                          reinterpret_cast<void *>(offsetof(Vertex::Data, bitangent)));
+
+    // tbn matrix
+    glEnableVertexAttribArray(Vertex::Layout::TBN);
+    glVertexAttribPointer(Vertex::Layout::TBN, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex::Data),
+                          reinterpret_cast<void *>(offsetof(Vertex::Data, TBN)));
+}
+
+void StaticGeometry::multiDraw(const std::span<const Range> ranges) const {
+    // neighbouring ranges, like a row of terrain chunks, collapse into one
+    merged.clear();
+    for (const auto &range: ranges) {
+        if (!merged.empty() && merged.back().first + static_cast<GLuint>(merged.back().count) == range.first) {
+            merged.back().count += range.count;
+        } else {
+            merged.push_back(range);
+        }
+    }
+
+    if (indirect) {
+        commands.clear();
+        for (const auto &[first, count]: merged) {
+            commands.push_back({static_cast<GLuint>(count), 1, first, 0, 0});
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(commands.size() * sizeof(DrawCommand)),
+                     commands.data(), GL_STREAM_DRAW);
+        GpuMemory::Track(GpuMemory::Object::BUFFER, indirectBuffer, GpuMemory::Category::GEOMETRY,
+                         commands.size() * sizeof(DrawCommand), "Static geometry");
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(commands.size()),
+                                    0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return;
+    }
+
+    counts.clear();
+    offsets.clear();
+    for (const auto &[first, count]: merged) {
+        counts.push_back(count);
+        offsets.push_back(reinterpret_cast<const void *>(first * sizeof(GLuint)));
+    }
+
+    glMultiDrawElements(GL_TRIANGLES, counts.data(), GL_UNSIGNED_INT, offsets.data(),
+                        static_cast<GLsizei>(counts.size()));
+}
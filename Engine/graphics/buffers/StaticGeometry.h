@@ -0,0 +1,105 @@
+//
+// Created by Jacob Edwards on 16/05/2024.
+//
+/*
+ * https://www.khronos.org/opengl/wiki/Vertex_Rendering#Multi-Draw
+ * https://www.khronos.org/opengl/wiki/Vertex_Rendering#Indirect_rendering
+ */
+
+#ifndef CW_STATICGEOMETRY_H
+#define CW_STATICGEOMETRY_H
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "graphics/Mesh.h"
+#include "graphics/Model.h"
+#include "graphics/Shader.h"
+#include "graphics/Vertex.h"
+#include "utils/Singleton.h"
+
+// one vao, vbo and ebo shared by every mesh that never moves. geometry is baked into world space when
+// added and indices are rebased onto the shared vertex buffer, so any set of ranges is a single multi draw
+class StaticGeometry final : public Singleton<StaticGeometry> {
+public:
+    struct Range {
+        GLuint first = 0;
+        GLsizei count = 0;
+    };
+
+    // a baked mesh and where it ended up, the mesh is kept for its material
+    struct Part {
+        const Mesh *mesh = nullptr;
+        Range range;
+    };
+
+    explicit StaticGeometry(Token);
+
+    ~StaticGeometry() override;
+
+    // geometry that is already in world space
+    auto add(std::span<const Vertex::Data> vertices, std::span<const GLuint> indices) -> Range;
+
+    // one copy of the mesh per transform, laid out back to back so they share a range
+    auto add(const Mesh &mesh, std::span<const glm::mat4> transforms) -> Range;
+
+    auto add(const Model &model, std::span<const glm::mat4> transforms) -> std::vector<Part>;
+
+    // moves everything onto the gpu and drops the cpu copies, only done once
+    void upload();
+
+    void bind() const;
+
+    void unbind() const;
+
+    void draw(std::span<const Range> ranges) const;
+
+    // binds each part's material then draws it, model is left as the identity
+    void draw(const std::shared_ptr<Shader> &shader, std::span<const Part> parts) const;
+
+    // every range in one call, for depth only passes
+    void drawAll() const;
+
+    void interface() const;
+
+private:
+    // matches the layout glMultiDrawElementsIndirect reads
+    struct DrawCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLuint EBO = 0;
+    GLuint indirectBuffer = 0;
+
+    // gl 4.3, otherwise falls back to glMultiDrawElements
+    bool indirect = false;
+
+    std::vector<Vertex::Data> vertices;
+    std::vector<GLuint> indices;
+
+    std::size_t vertexCount = 0;
+    std::size_t indexCount = 0;
+
+    // reused between draws
+    mutable std::vector<Range> merged;
+    mutable std::vector<GLsizei> counts;
+    mutable std::vector<const void *> offsets;
+    mutable std::vector<DrawCommand> commands;
+
+    void setup() const;
+
+    void multiDraw(std::span<const Range> ranges) const;
+};
+
+
+#endif //CW_STATICGEOMETRY_H
@@ -6,16 +6,56 @@
 #define CW_UNIFORMBUFFER_H
 
 #include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <GL/glew.h>
 
+#include "graphics/GpuMemory.h"
+
 class UniformBuffer {
 public:
-    explicit UniformBuffer(const size_t size) : size(size) {
+    // the owner is what the gpu memory panel lists it under
+    explicit UniformBuffer(const size_t size, const GLenum usage = GL_STATIC_DRAW,
+                           const std::string_view owner = "Uniform buffer") : size(size) {
         glGenBuffers(1, &id);
         glBindBuffer(GL_UNIFORM_BUFFER, id);
-        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_STATIC_DRAW);
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, usage);
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        GpuMemory::Track(GpuMemory::Object::BUFFER, id, GpuMemory::Category::SHADER_DATA, size, owner);
+    }
+
+    ~UniformBuffer() {
+        if (id != 0) {
+            GpuMemory::Release(GpuMemory::Object::BUFFER, id);
+            glDeleteBuffers(1, &id);
+        }
+    }
+
+    UniformBuffer(const UniformBuffer &) = delete;
+
+    auto operator=(const UniformBuffer &) -> UniformBuffer & = delete;
+
+    UniformBuffer(UniformBuffer &&other) noexcept : id(std::exchange(other.id, 0)), size(std::exchange(other.size, 0)),
+                                                    offsets(std::move(other.offsets)), sizes(std::move(other.sizes)) {
+    }
+
+    auto operator=(UniformBuffer &&other) noexcept -> UniformBuffer & {
+        if (this != &other) {
+            if (id != 0) {
+                GpuMemory::Release(GpuMemory::Object::BUFFER, id);
+                glDeleteBuffers(1, &id);
+            }
+
+            id = std::exchange(other.id, 0);
+            size = std::exchange(other.size, 0);
+            offsets = std::move(other.offsets);
+            sizes = std::move(other.sizes);
+        }
+
+        return *this;
     }
 
     void bind() const {
@@ -48,15 +88,22 @@ public:
         unbind();
     }
 
+    // for blocks whose binding is set elsewhere
+    void bindBase(const GLuint bindingPoint) const {
+        glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, id);
+    }
+
     void bindToShader(const GLuint bindingPoint, const GLuint shaderProgram, const std::string &blockName) const {
         const auto blockIndex = glGetUniformBlockIndex(shaderProgram, blockName.c_str());
-        glUniformBlockBinding(shaderProgram, blockIndex, bindingPoint);
+        if (blockIndex != GL_INVALID_INDEX) {
+            glUniformBlockBinding(shaderProgram, blockIndex, bindingPoint);
+        }
         glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, id);
     }
 
 private:
-    GLuint id;
-    size_t size;
+    GLuint id = 0;
+    size_t size = 0;
     std::vector<GLint> offsets;
     std::vector<GLint> sizes;
 };
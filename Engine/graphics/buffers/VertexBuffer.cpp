@@ -3,21 +3,37 @@
 //
 
 #include "graphics/buffers/VertexBuffer.h"
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <initializer_list>
 #include <span>
 #include <GL/glew.h>
 #include <utility>
 #include <vector>
+#include "graphics/GpuMemory.h"
 #include "graphics/Vertex.h"
+#include "App.h"
 
 VertexBuffer::VertexBuffer() {
+    // headless buffers keep their data on the cpu side only
+    if (App::headless) {
+        return;
+    }
+
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
 }
 
 VertexBuffer::~VertexBuffer() {
+    if (App::headless) {
+        return;
+    }
+
+    GpuMemory::Release(GpuMemory::Object::BUFFER, VBO);
+    GpuMemory::Release(GpuMemory::Object::BUFFER, EBO);
+
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &EBO);
@@ -26,16 +42,24 @@ VertexBuffer::~VertexBuffer() {
 
 VertexBuffer::VertexBuffer(const VertexBuffer &other) {
     if (this != &other) {
+        // there is nothing left to upload from once the data has gone
+        assert(other.retention == Retention::KEEP && "Copying a vertex buffer that dropped its data");
         data = other.data;
         drawMode = other.drawMode;
+        owner = other.owner;
+        retention = other.retention;
         setup();
     }
 }
 
 auto VertexBuffer::operator=(const VertexBuffer &other) -> VertexBuffer & {
     if (this != &other) {
+        // there is nothing left to upload from once the data has gone
+        assert(other.retention == Retention::KEEP && "Copying a vertex buffer that dropped its data");
         data = other.data;
         drawMode = other.drawMode;
+        owner = other.owner;
+        retention = other.retention;
         setup();
     }
     return *this;
@@ -45,6 +69,10 @@ auto VertexBuffer::operator=(const VertexBuffer &other) -> VertexBuffer & {
 VertexBuffer::VertexBuffer(VertexBuffer &&other) noexcept {
     data = std::move(other.data);
     drawMode = other.drawMode;
+    owner = other.owner;
+    retention = other.retention;
+    vertexCount = other.vertexCount;
+    indexCount = other.indexCount;
     VAO = other.VAO;
     VBO = other.VBO;
     EBO = other.EBO;
@@ -59,6 +87,10 @@ auto VertexBuffer::operator=(VertexBuffer &&other) noexcept -> VertexBuffer & {
     if (this != &other) {
         data = std::move(other.data);
         drawMode = other.drawMode;
+        owner = other.owner;
+        retention = other.retention;
+        vertexCount = other.vertexCount;
+        indexCount = other.indexCount;
         VAO = other.VAO;
         VBO = other.VBO;
         EBO = other.EBO;
@@ -88,6 +120,13 @@ void VertexBuffer::fill(std::span<const Vertex::Data> vertices,
     setup();
 }
 
+void VertexBuffer::fill(std::vector<Vertex::Data> &&vertices, std::vector<GLuint> &&indices) {
+    data.vertices = std::move(vertices);
+    data.indices = std::move(indices);
+
+    setup();
+}
+
 void VertexBuffer::fill(const std::initializer_list<Vertex::Data> vertices) {
     data.vertices = std::vector(vertices.begin(), vertices.end());
     setup();
@@ -98,6 +137,39 @@ void VertexBuffer::fill(std::span<const Vertex::Data> vertices) {
     setup();
 }
 
+void VertexBuffer::retain(const Retention policy) {
+    retention = policy;
+    Retain(data, policy);
+}
+
+void VertexBuffer::Retain(Data &data, const Retention policy) {
+    switch (policy) {
+        case Retention::KEEP:
+            break;
+        case Retention::DISCARD:
+            data = {};
+            break;
+        case Retention::POSITIONS:
+            // already reduced, the positions are all that's left
+            if (data.vertices.empty()) {
+                break;
+            }
+
+            data.positions.resize(data.vertices.size());
+            std::ranges::transform(data.vertices, data.positions.begin(), &Vertex::Data::position);
+            data.vertices = {};
+            break;
+    }
+}
+
+auto VertexBuffer::getVertexCount() const -> GLsizei {
+    return vertexCount;
+}
+
+auto VertexBuffer::getIndexCount() const -> GLsizei {
+    return indexCount;
+}
+
 void VertexBuffer::bind() const {
     glBindVertexArray(VAO);
 }
@@ -107,15 +179,27 @@ void VertexBuffer::unbind() const {
 }
 
 void VertexBuffer::draw() const {
-    if (!data.indices.empty()) {
-        glDrawElements(drawMode, static_cast<GLsizei>(data.indices.size()),
-                       GL_UNSIGNED_INT, nullptr);
+    if (indexCount != 0) {
+        glDrawElements(drawMode, indexCount, GL_UNSIGNED_INT, nullptr);
     } else {
-        glDrawArrays(drawMode, 0, static_cast<GLsizei>(data.vertices.size()));
+        glDrawArrays(drawMode, 0, vertexCount);
     }
 }
 
-void VertexBuffer::setup() const {
+void VertexBuffer::setup() {
+    vertexCount = static_cast<GLsizei>(data.vertices.size());
+    indexCount = static_cast<GLsizei>(data.indices.size());
+    // left over from an earlier fill
+    data.positions = {};
+
+    if (!App::headless) {
+        upload();
+    }
+
+    Retain(data, retention);
+}
+
+void VertexBuffer::upload() const {
     bind();
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
@@ -123,12 +207,16 @@ void VertexBuffer::setup() const {
         GL_ARRAY_BUFFER,
         static_cast<GLsizeiptr>(data.vertices.size() * sizeof(Vertex::Data)),
         data.vertices.data(), GL_STATIC_DRAW);
+    GpuMemory::Track(GpuMemory::Object::BUFFER, VBO, GpuMemory::Category::GEOMETRY,
+                     data.vertices.size() * sizeof(Vertex::Data), owner);
 
     if (!data.indices.empty()) {
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER,
                      static_cast<GLsizeiptr>(data.indices.size() * sizeof(GLuint)),
                      data.indices.data(), GL_STATIC_DRAW);
+        GpuMemory::Track(GpuMemory::Object::BUFFER, EBO, GpuMemory::Category::GEOMETRY,
+                         data.indices.size() * sizeof(GLuint), owner);
     }
 
     // vertex positions
@@ -170,10 +258,9 @@ void VertexBuffer::setup() const {
 }
 
 void VertexBuffer::drawInstanced(const std::size_t num) const {
-    if (!data.indices.empty()) {
-        glDrawElementsInstanced(drawMode, static_cast<GLsizei>(data.indices.size()), GL_UNSIGNED_INT, nullptr,
-                                static_cast<GLsizei>(num));
+    if (indexCount != 0) {
+        glDrawElementsInstanced(drawMode, indexCount, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(num));
     } else {
-        glDrawArraysInstanced(drawMode, 0, static_cast<GLsizei>(data.vertices.size()), static_cast<GLsizei>(num));
+        glDrawArraysInstanced(drawMode, 0, vertexCount, static_cast<GLsizei>(num));
     }
 }
@@ -8,7 +8,10 @@
 #include "graphics/Vertex.h"
 #include <GL/glew.h>
 #include <cstddef>
+#include <cstdint>
+#include <glm/ext/vector_float3.hpp>
 #include <initializer_list>
+#include <string_view>
 #include <vector>
 
 #include <span>
@@ -21,13 +24,30 @@ public:
 
     GLenum drawMode = GL_TRIANGLES;
 
+    // what the gpu memory panel files this buffer's storage under, set before filling it
+    std::string_view owner = "Vertex buffer";
+
+    // what stays on the cpu once the gpu has a copy. draws only need the counts, so unless something reads
+    // the vertices back, such as baking into static geometry, they are dead weight after the upload
+    enum class Retention : std::uint8_t {
+        KEEP,
+        DISCARD,
+        // positions and indices, enough for collision meshes
+        POSITIONS,
+    };
+
     struct Data {
         std::vector<Vertex::Data> vertices;
         std::vector<GLuint> indices;
+        // only filled with Retention::POSITIONS
+        std::vector<glm::vec3> positions;
     };
 
     Data data;
 
+    // applied after every fill, set before filling it
+    Retention retention = Retention::KEEP;
+
     VertexBuffer();
 
     ~VertexBuffer();
@@ -44,10 +64,23 @@ public:
 
     void fill(std::span<const Vertex::Data> vertices, std::span<const GLuint> indices);
 
+    // takes the vectors over rather than copying them
+    void fill(std::vector<Vertex::Data> &&vertices, std::vector<GLuint> &&indices);
+
     void fill(std::initializer_list<Vertex::Data> vertices);
 
     void fill(std::span<const Vertex::Data> vertices);
 
+    // drops the cpu copy now, for buffers whose data was only needed until some later point
+    void retain(Retention policy);
+
+    // applies a policy to data the caller owns, the buffer uses it on its own copy
+    static void Retain(Data &data, Retention policy);
+
+    [[nodiscard]] auto getVertexCount() const -> GLsizei;
+
+    [[nodiscard]] auto getIndexCount() const -> GLsizei;
+
     void bind() const;
 
     void unbind() const;
@@ -64,7 +97,13 @@ public:
     void drawInstanced(std::size_t num) const;
 
 private:
-    void setup() const;
+    // what was uploaded, kept apart from data so draws still work once it has been dropped
+    GLsizei vertexCount = 0;
+    GLsizei indexCount = 0;
+
+    void setup();
+
+    void upload() const;
 };
 
 #endif // CW_BUFFER_H
@@ -51,6 +51,7 @@ Physics::Spline::Spline(std::span<const glm::vec3> points, const Type type, cons
     }
 
     buffer = std::make_unique<VertexBuffer>();
+    buffer->owner = "Splines";
     std::vector<Vertex::Data> vertices;
     vertices.reserve(numPoints + 1U);
 
@@ -10,25 +10,44 @@
 #include <glm/ext/vector_float3.hpp>
 #include <memory>
 #include <filesystem>
-#include <unordered_map>
 #include <utility>
 #include "graphics/Shader.h"
 #include "utils/BoundingBox.h"
 #include "graphics/Model.h"
 #include "physics/ModelAttributes.h"
 #include "App.h"
+#include "utils/AssetManager.h"
 
-std::unordered_map<std::filesystem::path, std::shared_ptr<Model> > Entity::models;
+// shared through the asset manager so every entity using a model lands in the same instanced batch
+Entity::Entity(const std::filesystem::path &path) : model(AssetManager::GetInstance().getModel(path)) {
+    box = model->getBoundingBox();
+}
+
+Entity::Entity(Entity &&other) noexcept : Renderable(std::move(other)), attributes(std::move(other.attributes)),
+                                          model(std::move(other.model)), box(std::move(other.box)),
+                                          children(std::move(other.children)),
+                                          parent(std::exchange(other.parent, nullptr)), node(std::move(other.node)) {
+    for (const auto &child: children) {
+        child->parent = this;
+    }
+}
 
-Entity::Entity(const std::filesystem::path &path) {
-    if (const auto it = models.find(path); it != models.end()) {
-        model = it->second;
-    } else {
-        model = std::make_shared<Model>(path);
-        models.emplace(path, model);
+auto Entity::operator=(Entity &&other) noexcept -> Entity & {
+    if (this != &other) {
+        Renderable::operator=(std::move(other));
+        attributes = std::move(other.attributes);
+        model = std::move(other.model);
+        box = std::move(other.box);
+        children = std::move(other.children);
+        parent = std::exchange(other.parent, nullptr);
+        node = std::move(other.node);
+
+        for (const auto &child: children) {
+            child->parent = this;
+        }
     }
 
-    box = model->getBoundingBox();
+    return *this;
 }
 
 void Entity::update(const float deltaTime) {
@@ -39,6 +58,8 @@ void Entity::update(const float deltaTime) {
     const auto translation = glm::vec3(newTransform[3]) - glm::vec3(oldTransform[3]);
 
     box.translate(translation);
+
+    syncTransform();
 }
 
 void Entity::draw(const glm::mat4 &view, const glm::mat4 &projection) const {
@@ -90,6 +111,8 @@ void Entity::translate(const glm::vec3 &translation) {
     attributes.transform = glm::translate(attributes.getTransform(), translation);
 
     box.translate(translation);
+
+    syncTransform();
 }
 
 void Entity::transform(const glm::mat4 &transformation) {
@@ -98,6 +121,8 @@ void Entity::transform(const glm::mat4 &transformation) {
             glm::vec3(attributes.getTransform() * glm::vec4(attributes.position, 1.0F));
 
     box.transform(transformation);
+
+    syncTransform();
 }
 
 void Entity::scale(const glm::vec3 &scale) {
@@ -113,3 +138,33 @@ void Entity::rotate(const glm::vec3 &axis, const float angle) {
 void Entity::collisionResponse() {
     attributes.isColliding = true;
 }
+
+auto Entity::addChild(std::unique_ptr<Entity> child) -> Entity & {
+    child->attachTo(this);
+    children.push_back(std::move(child));
+    return *children.back();
+}
+
+void Entity::attachTo(Entity *parent) {
+    this->parent = parent;
+    node.setParent(parent != nullptr ? &parent->node : nullptr);
+}
+
+void Entity::setLocalTransform(const glm::mat4 &local) {
+    node.setLocal(local);
+}
+
+auto Entity::getLocalTransform() const -> glm::mat4 {
+    return node.getLocal();
+}
+
+auto Entity::getWorldTransform() const -> glm::mat4 {
+    return node.getWorld();
+}
+
+void Entity::syncTransform() {
+    // a child is placed by its parent, only roots are driven by their physics
+    if (parent == nullptr) {
+        node.setLocal(attributes.getTransform());
+    }
+}
@@ -15,7 +15,7 @@
 #include "graphics/Model.h"
 #include "physics/ModelAttributes.h"
 #include "renderables/Renderable.h"
-#include "unordered_map"
+#include "renderables/SceneGraph.h"
 
 class Entity : public Renderable {
 public:
@@ -31,9 +31,9 @@ public:
 
     auto operator=(const Entity &other) -> Entity & = delete;
 
-    Entity(Entity &&other) noexcept = default;
+    Entity(Entity &&other) noexcept;
 
-    auto operator=(Entity &&other) noexcept -> Entity & = default;
+    auto operator=(Entity &&other) noexcept -> Entity &;
 
     virtual void update(float deltaTime);
 
@@ -63,17 +63,34 @@ public:
 
     virtual void collisionResponse();
 
+    // takes ownership, the child's transform is relative to this entity from then on
+    auto addChild(std::unique_ptr<Entity> child) -> Entity &;
+
+    // follows an entity owned elsewhere, nullptr makes this a root again
+    void attachTo(Entity *parent);
+
+    void setLocalTransform(const glm::mat4 &local);
+
+    [[nodiscard]] auto getLocalTransform() const -> glm::mat4;
+
+    [[nodiscard]] auto getWorldTransform() const -> glm::mat4;
+
     Physics::Attributes attributes;
 
 protected:
     std::shared_ptr<Model> model;
 
-    static std::unordered_map<std::filesystem::path, std::shared_ptr<Model> > models;
-
     BoundingBox box;
 
+    // only the children this entity owns, ones attached from elsewhere just point back through parent
     std::vector<std::unique_ptr<Entity> > children;
     Entity *parent = nullptr;
+
+    // a root's local transform is its physics transform, copied in whenever the entity moves it
+    SceneGraph::Node node;
+
+private:
+    void syncTransform();
 };
 
 
@@ -4,6 +4,7 @@
 
 #include "Particle.h"
 
+#include <cstddef>
 #include <iostream>
 
 
@@ -22,6 +23,8 @@
 #include "utils/PlayerManager.h"
 #include "graphics/Color.h"
 #include "utils/Random.h"
+#include "utils/Allocations.h"
+#include "utils/Profiler.h"
 #include <vector>
 #include "imgui/imgui.h"
 
@@ -57,6 +60,9 @@ void ParticleSystem::add(const Particle &particle) {
 }
 
 void ParticleSystem::update(const float deltaTime) {
+    PROFILE_ZONE("Particles");
+    ALLOCATION_SCOPE(PARTICLES);
+
     const auto player = PlayerManager::GetInstance().getCurrent();
 
     const auto camera = player->getCamera();
@@ -119,6 +125,9 @@ void ParticleSystem::generate(const Physics::Attributes &attributes, const glm::
 
 void ParticleSystem::generate(const glm::vec3 &position, const glm::vec3 &velocity, const glm::vec3 &color,
                               const int numParticles, const float life, const float scale) {
+    // collisions spray from inside the physics phase
+    ALLOCATION_SCOPE(PARTICLES);
+
     for (int i = 0; i < numParticles; i++) {
         const auto pos = position + Random::Vec3(-3.0F, 3.0F);
         const auto vel = velocity * Random::Float(0.8F, 1.2F);
@@ -131,11 +140,19 @@ void ParticleSystem::generate(const glm::vec3 &position, const glm::vec3 &veloci
 
 
 void ParticleSystem::setup() {
+    // full up front, so generating never has to grow it mid frame
+    particles.reserve(static_cast<std::size_t>(MAX_PARTICLES));
+
     buffer = std::make_shared<VertexBuffer>();
+    buffer->owner = "Particles";
     shader = ShaderManager::GetInstance().get("Particle");
     buffer->fill(vertices, indices);
 }
 
+auto ParticleSystem::getParticles() const -> const std::vector<Particle> & {
+    return particles;
+}
+
 void ParticleSystem::interface() {
     ImGui::Begin("Particle System");
 
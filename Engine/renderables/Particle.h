@@ -57,6 +57,8 @@ public:
     void generate(const glm::vec3 &position, const glm::vec3 &velocity = glm::vec3(0.0F),
                   const glm::vec3 &color = Color::WHITE, int numParticles = 100, float life = 1.0F, float scale = 1.0F);
 
+    [[nodiscard]] auto getParticles() const -> const std::vector<Particle> &;
+
     void interface();
 
     explicit ParticleSystem(Token) : ParticleSystem() {
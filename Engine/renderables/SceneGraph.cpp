@@ -0,0 +1,246 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#include "SceneGraph.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+
+namespace SceneGraph {
+    namespace {
+        // a moved from node
+        constexpr Id NONE = std::numeric_limits<Id>::max();
+
+        struct Slot {
+            glm::mat4 local = Config::IDENTITY_MATRIX;
+            glm::mat4 world = Config::IDENTITY_MATRIX;
+            Id parent = NONE;
+            std::vector<Id> children;
+            // the pass that last recomputed it, a child that sees the current pass knows its parent moved
+            std::uint64_t pass = 0;
+            bool dirty = true;
+            bool alive = false;
+        };
+
+        struct State {
+            std::vector<Slot> slots;
+            std::vector<Id> free;
+            // every live node breadth first, roots in the order they were made
+            std::vector<Id> order;
+            std::uint64_t pass = 0;
+            std::size_t size = 0;
+            std::size_t recomputed = 0;
+            // a node was parented or destroyed, the order has to be rebuilt
+            bool reorder = false;
+            // something has changed since the last update
+            bool pending = false;
+        };
+
+        // never destroyed, entities held by singletons still release their nodes on the way out
+        auto Get() -> State & {
+            static auto *state = new State();
+            return *state;
+        }
+
+        void Reorder(State &state) {
+            state.order.clear();
+
+            for (Id id = 0; id < static_cast<Id>(state.slots.size()); id++) {
+                if (state.slots[id].alive && state.slots[id].parent == NONE) {
+                    state.order.push_back(id);
+                }
+            }
+
+            // the order doubles as the queue
+            for (std::size_t i = 0; i < state.order.size(); i++) {
+                for (const Id child: state.slots[state.order[i]].children) {
+                    state.order.push_back(child);
+                }
+            }
+
+            state.reorder = false;
+        }
+
+        void Unlink(State &state, const Id id) {
+            Slot &slot = state.slots[id];
+
+            if (slot.parent != NONE) {
+                std::erase(state.slots[slot.parent].children, id);
+                slot.parent = NONE;
+            }
+        }
+
+        auto Create() -> Id {
+            auto &state = Get();
+            Id id = 0;
+
+            if (!state.free.empty()) {
+                id = state.free.back();
+                state.free.pop_back();
+                state.slots[id] = Slot{};
+            } else {
+                id = static_cast<Id>(state.slots.size());
+                state.slots.emplace_back();
+            }
+
+            state.slots[id].alive = true;
+            state.size++;
+            state.pending = true;
+
+            // a root can go anywhere, so only a rebuild that is already due has to know about it
+            if (!state.reorder) {
+                state.order.push_back(id);
+            }
+
+            return id;
+        }
+
+        void Destroy(const Id id) {
+            auto &state = Get();
+
+            // so the orphans keep the world matrices they have now
+            Update();
+
+            Unlink(state, id);
+
+            for (const Id child: state.slots[id].children) {
+                Slot &orphan = state.slots[child];
+                orphan.parent = NONE;
+                orphan.local = orphan.world;
+            }
+
+            state.slots[id] = Slot{};
+            state.free.push_back(id);
+            state.size--;
+            state.reorder = true;
+        }
+    }
+
+    Node::Node() : id(Create()) {
+    }
+
+    Node::~Node() {
+        if (id != NONE) {
+            Destroy(id);
+        }
+    }
+
+    Node::Node(Node &&other) noexcept : id(std::exchange(other.id, NONE)) {
+    }
+
+    auto Node::operator=(Node &&other) noexcept -> Node & {
+        if (this != &other) {
+            if (id != NONE) {
+                Destroy(id);
+            }
+
+            id = std::exchange(other.id, NONE);
+        }
+
+        return *this;
+    }
+
+    void Node::setParent(const Node *parent) {
+        assert(id != NONE && "Use of a moved from scene graph node");
+        auto &state = Get();
+
+        const Id parentId = parent != nullptr ? parent->id : NONE;
+
+        if (state.slots[id].parent == parentId) {
+            return;
+        }
+
+#ifndef NDEBUG
+        for (Id ancestor = parentId; ancestor != NONE; ancestor = state.slots[ancestor].parent) {
+            assert(ancestor != id && "A scene graph node can't be parented to its own descendant");
+        }
+#endif
+
+        Unlink(state, id);
+
+        if (parentId != NONE) {
+            state.slots[parentId].children.push_back(id);
+            state.slots[id].parent = parentId;
+        }
+
+        state.slots[id].dirty = true;
+        state.reorder = true;
+        state.pending = true;
+    }
+
+    void Node::setLocal(const glm::mat4 &local) {
+        assert(id != NONE && "Use of a moved from scene graph node");
+        auto &state = Get();
+        Slot &slot = state.slots[id];
+
+        if (slot.local == local) {
+            return;
+        }
+
+        slot.local = local;
+        slot.dirty = true;
+        state.pending = true;
+    }
+
+    auto Node::getLocal() const -> glm::mat4 {
+        return id != NONE ? Get().slots[id].local : Config::IDENTITY_MATRIX;
+    }
+
+    auto Node::getWorld() const -> glm::mat4 {
+        if (id == NONE) {
+            return Config::IDENTITY_MATRIX;
+        }
+
+        Update();
+        return Get().slots[id].world;
+    }
+
+    void Update() {
+        auto &state = Get();
+
+        if (!state.pending) {
+            return;
+        }
+
+        if (state.reorder) {
+            Reorder(state);
+        }
+
+        const std::uint64_t pass = ++state.pass;
+        std::size_t recomputed = 0;
+
+        for (const Id id: state.order) {
+            Slot &slot = state.slots[id];
+            const Slot *parent = slot.parent != NONE ? &state.slots[slot.parent] : nullptr;
+
+            // nothing moved here or above, last pass's world still holds
+            if (!slot.dirty && (parent == nullptr || parent->pass != pass)) {
+                continue;
+            }
+
+            slot.world = parent != nullptr ? parent->world * slot.local : slot.local;
+            slot.pass = pass;
+            slot.dirty = false;
+            recomputed++;
+        }
+
+        state.recomputed = recomputed;
+        state.pending = false;
+    }
+
+    auto Size() -> std::size_t {
+        return Get().size;
+    }
+
+    auto Recomputed() -> std::size_t {
+        return Get().recomputed;
+    }
+}
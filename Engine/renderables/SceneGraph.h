@@ -0,0 +1,59 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_SCENEGRAPH_H
+#define CW_SCENEGRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/ext/matrix_float4x4.hpp>
+
+// transforms for things that ride on something else, the cabins on the ferris wheel or a driver in a car.
+// nodes are kept in breadth first order so one pass front to back always reaches a parent before its
+// children, and a node is only recomputed when its own local matrix or an ancestor's has changed since
+// the last pass. main thread only
+namespace SceneGraph {
+    using Id = std::uint32_t;
+
+    // owns one node and moves like a unique_ptr. the children of a node that goes away become roots
+    // where they stand
+    class Node {
+    public:
+        Node();
+
+        ~Node();
+
+        Node(const Node &) = delete;
+
+        auto operator=(const Node &) -> Node & = delete;
+
+        Node(Node &&other) noexcept;
+
+        auto operator=(Node &&other) noexcept -> Node &;
+
+        // nullptr makes it a root again, the local matrix is kept and now relative to the new parent
+        void setParent(const Node *parent);
+
+        // the same matrix as last time is ignored, so feeding one in every tick only costs when it moved
+        void setLocal(const glm::mat4 &local);
+
+        [[nodiscard]] auto getLocal() const -> glm::mat4;
+
+        // brings the graph up to date first if anything is waiting
+        [[nodiscard]] auto getWorld() const -> glm::mat4;
+
+    private:
+        Id id;
+    };
+
+    // recomputes whatever changed since the last call
+    void Update();
+
+    [[nodiscard]] auto Size() -> std::size_t;
+
+    // nodes the last update had to recompute
+    [[nodiscard]] auto Recomputed() -> std::size_t;
+}
+
+#endif //CW_SCENEGRAPH_H
@@ -7,10 +7,13 @@
 
 #include "utils/ShaderManager.h"
 #include "Config.h"
+#include "graphics/buffers/StaticGeometry.h"
+#include "utils/AssetManager.h"
 #include "renderables/Entity.h"
 
 
-Barriers::Barriers() : model("../Assets/objects/barrier/Concrete-Barrier_04.obj") {
+Barriers::Barriers() : model(
+    AssetManager::GetInstance().getModel("../Assets/objects/barrier/Concrete-Barrier_04.obj")) {
     shader = ShaderManager::GetInstance().get("Base");
     // draw along the above
     // left transforms
@@ -51,13 +54,15 @@ Barriers::Barriers() : model("../Assets/objects/barrier/Concrete-Barrier_04.obj"
         transforms.push_back(transform);
         frontPos.x += 42.0F;
     }
+
+    parts = StaticGeometry::GetInstance().add(*model, transforms);
 }
 
 void Barriers::draw(const std::shared_ptr<Shader> shader) const {
-    // draw lots of walls surrounding
-    for (const auto transform: transforms) {
-        shader->setUniform("model", transform);
-        model.draw(shader);
-    }
+    // draw lots of walls surrounding, baked into the static geometry so every copy is one range
+    shader->use();
+    shader->setUniform("time", 0.0F);
+    shader->setUniform("damage", 0.0F);
+    StaticGeometry::GetInstance().draw(shader, parts);
 }
 
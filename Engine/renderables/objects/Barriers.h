@@ -5,6 +5,7 @@
 #ifndef BARRIERS_H
 #define BARRIERS_H
 #include "graphics/Shader.h"
+#include "graphics/buffers/StaticGeometry.h"
 #include <renderables/Entity.h>
 #include <utils/ShaderManager.h>
 
@@ -19,7 +20,8 @@ public:
 
 private:
     std::vector<glm::mat4> transforms;
-    Model model;
+    std::shared_ptr<Model> model;
+    std::vector<StaticGeometry::Part> parts;
 };
 
 
@@ -16,15 +16,20 @@
 #include <memory>
 #include <vector>
 #include "graphics/Color.h"
+#include "graphics/GpuMemory.h"
+#include "graphics/InstanceBatcher.h"
 #include "graphics/Model.h"
 #include "physics/Spline.h"
 #include "utils/Lights.h"
+#include "utils/AssetManager.h"
 #include "utils/PlayerManager.h"
 #include "renderables/Entity.h"
 #include "App.h"
 #include "graphics/Shader.h"
 #include "imgui/imgui.h"
 #include "utils/Random.h"
+#include "utils/StartupTimeline.h"
+#include "utils/FrameArena.h"
 #include <GL/glew.h>
 #include <utils/ShaderManager.h>
 
@@ -35,10 +40,14 @@ float BumperCar::coneHeight = 100.0F;
 bool BumperCar::paused = false;
 float BumperCar::trackingDistance = 25.0F;
 float BumperCar::ventureDistance = 100.0F;
+Texture::Data BumperCar::damageTexture;
 
 BumperCar::BumperCar(const glm::vec2 centre, const float radius, const float speed) : Entity(
         "../Assets/objects/bumpercar1/bumper-car.obj"), speed(speed),
-    person("../Assets/objects/person-sitting/person.obj") {
+    personBody(AssetManager::GetInstance().getModel("../Assets/objects/person-sitting/person.obj")),
+    personBodyless(AssetManager::GetInstance().getModel("../Assets/objects/person-sitting/bodyless.obj")) {
+    person = personBody;
+
     const int numPoints = Random::Int(10, 30);
 
     float angle = 0.0F;
@@ -82,10 +91,19 @@ BumperCar::BumperCar(const glm::vec2 centre, const float radius, const float spe
     spline.randomise();
 
     attributes.mass = 10.0F;
-    generateTexture();
+
+    if (damageTexture.id == 0 && !App::headless) {
+        const StartupTimeline::Scope scope("Damage texture");
+        GenerateTexture();
+    }
 
     personShader = ShaderManager::GetInstance().get("Untextured");
     shader = ShaderManager::GetInstance().get("Base");
+
+    // back from the front of the car
+    seat.setParent(&node);
+    seat.setLocal(glm::scale(glm::translate(Config::IDENTITY_MATRIX, glm::vec3(0.0F, -0.25F, -0.45F)),
+                             glm::vec3(0.35F)));
 }
 
 auto BumperCar::getLaps() const -> std::size_t {
@@ -126,7 +144,7 @@ void BumperCar::reset() {
     attributes.mass = 10.0F;
 }
 
-void BumperCar::generateTexture() {
+void BumperCar::GenerateTexture() {
     GLuint texture;
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
@@ -146,6 +164,9 @@ void BumperCar::generateTexture() {
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 512, 512, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
     glGenerateMipmap(GL_TEXTURE_2D);
+    // a third more for the mips
+    GpuMemory::Track(GpuMemory::Object::TEXTURE, texture, GpuMemory::Category::TEXTURES, data.size() + data.size() / 3,
+                     "Bumper cars");
     // parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -245,9 +266,13 @@ void BumperCar::update(const float deltaTime) {
             auto closest = glm::vec3(0.0F);
             auto closestDistance = std::numeric_limits<float>::max();
 
-            std::vector<glm::vec3> positionList(trackablePositions.size() + trackableEntities.size() + 1U);
+            // only needed for this update, so it comes from the frame arena rather than the heap
+            const std::size_t tracked = trackablePositions.size() + trackableEntities.size();
+            FrameArena::Vector<glm::vec3> positionList(FrameArena::GetInstance().resource());
+            positionList.reserve(tracked * 2U + 1U);
+            positionList.resize(tracked + 1U);
 
-            for (const auto &entity: trackableEntities) {
+            for (const Entity *entity: trackableEntities) {
                 positionList.emplace_back(entity->attributes.getPosition());
             }
 
@@ -294,7 +319,7 @@ void BumperCar::takeDamage(const float damage) {
     this->damageTaken += damage;
 }
 
-void BumperCar::addTrackableEntity(const std::shared_ptr<Entity> &entity) {
+void BumperCar::addTrackableEntity(const Entity *entity) {
     if (entity == nullptr) {
         return;
     }
@@ -303,7 +328,7 @@ void BumperCar::addTrackableEntity(const std::shared_ptr<Entity> &entity) {
         return;
     }
 
-    if (entity.get() == this) {
+    if (entity == this) {
         return;
     }
 
@@ -328,39 +353,32 @@ auto BumperCar::getMode() const -> Mode {
 }
 
 
+// submits the car and its driver to the instance batcher, drawn when the caller flushes it
 void BumperCar::draw(const std::shared_ptr<Shader> shader) const {
-    personShader->use();
-    auto mat = attributes.getTransform();
-    // tranlte back based on front of car
-    mat = glm::translate(mat, glm::vec3(0.0F, -0.25F, -0.45F));
+    InstanceBatcher &batcher = InstanceBatcher::GetInstance();
 
-    mat = glm::scale(mat, glm::vec3(0.35F));
-    personShader->setUniform("model", mat);
+    if (drawPlayer && !isBroken) {
+        Instance driver;
+        driver.model = seat.getWorld();
+        driver.color = glm::vec4(isPlayer ? Color::RED : Color::YELLOW, 1.0F);
 
-    if (!isPlayer) {
-        personShader->setUniform("color", Color::YELLOW);
-    } else {
-        personShader->setUniform("color", Color::RED);
+        batcher.submit(personShader, *person, driver);
     }
 
-    if (drawPlayer && !isBroken) {
-        person.draw(personShader);
-    }
+    // damage texture
+    glActiveTexture(GL_TEXTURE0 + DAMAGE_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, damageTexture.id);
+    glActiveTexture(GL_TEXTURE0);
 
     shader->use();
-    // damage texture
-    mat = attributes.getTransform();
-    shader->setUniform("model", mat);
-    shader->setUniform("time", explodeTime / 2.0F);
-    shader->setUniform("damage", damageTaken);
+    shader->setUniform("damageTexture", DAMAGE_TEXTURE_UNIT);
 
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, damageTexture.id);
-    shader->setUniform("damageTexture", 1);
+    Instance car;
+    car.model = attributes.getTransform();
+    car.params = glm::vec4(damageTaken, explodeTime / 2.0F, 0.0F, 0.0F);
 
-    model->draw(shader);
+    batcher.submit(shader, *model, car);
 
-    shader->setUniform("damage", 0.0F);
     if (App::debug) {
         spline.draw(shader);
     }
@@ -401,14 +419,26 @@ void BumperCar::shouldDrawPlayer(const bool draw) {
     drawPlayer = draw;
 }
 
-void BumperCar::Interface() {
+auto BumperCar::Interface(const bool tuning) -> std::optional<bool> {
+    std::optional<bool> requested;
+
     ImGui::Begin("Bumper Car Debug");
+    ImGui::BeginDisabled(!tuning);
     ImGui::SliderFloat("Cone Radius", &coneRadius, 0.0F, 360.0F);
     ImGui::SliderFloat("Cone Height", &coneHeight, 0.0F, 125.0F);
     ImGui::SliderFloat("Tracking Distance", &trackingDistance, 0.0F, 100.0F);
     ImGui::SliderFloat("Venture Distance", &ventureDistance, 0.0F, 1000.0F);
-    ImGui::Checkbox("Paused", &paused);
+    ImGui::EndDisabled();
+    if (bool value = paused; ImGui::Checkbox("Paused", &value)) {
+        requested = value;
+    }
     ImGui::End();
+
+    return requested;
+}
+
+void BumperCar::SetPaused(const bool value) {
+    paused = value;
 }
 
 auto BumperCar::hasBroke() const -> bool {
@@ -422,9 +452,9 @@ void BumperCar::setIsPlayer(const bool isPlayer) {
 void BumperCar::isCurrentPlayer(const bool isCurrentPlayer) {
     this->currentPlayer = isCurrentPlayer;
     if (isCurrentPlayer && !thirdPerson) {
-        person = Model("../Assets/objects/person-sitting/bodyless.obj");
+        person = personBodyless;
     } else {
-        person = Model("../Assets/objects/person-sitting/person.obj");
+        person = personBody;
     }
 }
 
@@ -473,10 +503,10 @@ auto BumperCar::isOnFire() const -> bool {
 void BumperCar::isThirdPerson(const bool thirdPerson) {
     this->thirdPerson = thirdPerson;
     if (thirdPerson && currentPlayer) {
-        person = Model("../Assets/objects/person-sitting/person.obj");
+        person = personBody;
     }
     if (!thirdPerson && currentPlayer) {
-        person = Model("../Assets/objects/person-sitting/bodyless.obj");
+        person = personBodyless;
     }
 }
 
@@ -9,10 +9,15 @@
 #include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_float3.hpp>
 #include <memory>
+#include <optional>
 #include <vector>
 #include "renderables/Entity.h"
+#include "renderables/SceneGraph.h"
 #include "utils/Lights.h"
 
+// texture unit the damage noise is bound to, clear of the material textures
+constexpr int DAMAGE_TEXTURE_UNIT = 9;
+
 class BumperCar final : public Entity {
 public:
     using Entity::draw;
@@ -33,7 +38,7 @@ public:
 
     void reset();
 
-    void generateTexture();
+    static void GenerateTexture();
 
     void draw(std::shared_ptr<Shader> shader) const override;
 
@@ -49,7 +54,8 @@ public:
 
     void addTrackablePosition(glm::vec3 position);
 
-    void addTrackableEntity(const std::shared_ptr<Entity> &entity);
+    // only pointed at, whatever is tracked has to outlive the car
+    void addTrackableEntity(const Entity *entity);
 
     void clearTrackablePositions();
 
@@ -59,7 +65,10 @@ public:
 
     [[nodiscard]] auto getLaps() const -> std::size_t;
 
-    static void Interface();
+    // whether the cars should be paused, when that was changed, for the caller to apply with SetPaused
+    [[nodiscard]] static auto Interface(bool tuning = true) -> std::optional<bool>;
+
+    static void SetPaused(bool value);
 
     void takeDamage(float damage);
 
@@ -92,12 +101,18 @@ private:
     Physics::Spline spline;
     std::vector<glm::vec3> points;
     std::vector<glm::vec3> trackablePositions;
-    std::vector<std::shared_ptr<Entity> > trackableEntities;
+    std::vector<const Entity *> trackableEntities;
 
-    Model person;
+    // whichever of the two below is drawn, switching is a handle swap
+    std::shared_ptr<Model> person;
+    std::shared_ptr<Model> personBody;
+    std::shared_ptr<Model> personBodyless;
     std::shared_ptr<Shader> personShader;
+    // where the driver sits, a child of the car's node
+    SceneGraph::Node seat;
 
-    Texture::Data damageTexture;
+    // the noise is the same for every car, so they all share one texture and one batch
+    static Texture::Data damageTexture;
 
     static float coneRadius;
     static float coneHeight;
@@ -9,48 +9,81 @@
 
 #include "renderables/Renderable.h"
 #include "graphics/Model.h"
+#include <cmath>
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
 #include <graphics/Color.h>
+#include <utils/AssetManager.h>
+
+namespace {
+    // a turn about the x axis through a point
+    auto RotateAbout(const glm::vec3 &point, const float angle) -> glm::mat4 {
+        return glm::translate(Config::IDENTITY_MATRIX, point) *
+               glm::rotate(Config::IDENTITY_MATRIX, angle, glm::vec3(1.0F, 0.0F, 0.0F)) *
+               glm::translate(Config::IDENTITY_MATRIX, -point);
+    }
+}
 
 FerrisWheel::FerrisWheel() : Entity("../Assets/objects/ferris/ferris-static.obj"),
-                             staticPart("../Assets/objects/ferris/ferris-static.obj"),
-                             rotatingPart("../Assets/objects/ferris/ferris-moving.obj"),
-                             cabin("../Assets/objects/ferris/ferris-cart.obj"),
-                             entrance("../Assets/objects/enterance/enterance.obj") {
+                             entrance(AssetManager::GetInstance().getModel(
+                                 "../Assets/objects/enterance/enterance.obj")) {
     shader = ShaderManager::GetInstance().get("Untextured");
 
     staticPartTransform = glm::scale(staticPartTransform, scale);
-    rotatingPartTransform = glm::scale(rotatingPartTransform, scale);
-    cabinTransform = glm::scale(cabinTransform, scale);
-
     staticPartTransform = glm::translate(staticPartTransform, translation);
-    rotatingPartTransform = glm::translate(rotatingPartTransform, translation);
-    cabinTransform = glm::translate(cabinTransform, translation);
 
     entranceTransform = glm::translate(entranceTransform, glm::vec3(-10.0F, 0.0F, 40.0F));
 
+    staticParts = StaticGeometry::GetInstance().add(*model, std::span(&staticPartTransform, 1));
+
+    setLocalTransform(staticPartTransform);
+
+    wheel = &addChild(std::make_unique<Entity>("../Assets/objects/ferris/ferris-moving.obj"));
+
+    for (int i = 0; i < CABINS; i++) {
+        cabins.push_back(&wheel->addChild(std::make_unique<Entity>("../Assets/objects/ferris/ferris-cart.obj")));
+    }
+
+    // places the cabins around the wheel
+    update(0.0F);
+
     attributes.mass = 1000.0F;
     attributes.gravityAffected = false;
 }
 
 void FerrisWheel::draw(const std::shared_ptr<Shader> shader) const {
+    drawStatic(shader);
+    drawDynamic(shader);
+}
+
+void FerrisWheel::drawStatic(const std::shared_ptr<Shader> &shader) const {
     shader->use();
     shader->setUniform("color", Color::WHITE);
-    shader->setUniform("model", staticPartTransform);
-    staticPart.draw(shader);
+    StaticGeometry::GetInstance().draw(shader, staticParts);
+}
 
-    shader->setUniform("model", rotatingPartTransform);
-    rotatingPart.draw(shader);
+void FerrisWheel::drawDynamic(const std::shared_ptr<Shader> &shader) const {
+    shader->use();
+    shader->setUniform("color", Color::WHITE);
+    shader->setUniform("model", wheel->getWorldTransform());
+    wheel->getModel().draw(shader);
 
-    // shader->setUniform("model", cabinTransform);
-    // cabin.draw(shader);
+    for (const Entity *cabin: cabins) {
+        shader->setUniform("model", cabin->getWorldTransform());
+        cabin->getModel().draw(shader);
+    }
 }
 
 void FerrisWheel::update(const float deltaTime) {
-    const glm::mat4 translationToCenter = glm::translate(glm::mat4(1.0F), -centre);
-    const glm::mat4 rotation = glm::rotate(glm::mat4(1.0F), deltaTime, glm::vec3(1.0F, 0.0F, 0.0F));
-    const glm::mat4 translationBack = glm::translate(glm::mat4(1.0F), centre);
+    angle = std::fmod(angle + deltaTime, glm::two_pi<float>());
+    wheel->setLocalTransform(RotateAbout(HUB, angle));
 
-    rotatingPartTransform = translationBack * rotation * translationToCenter * rotatingPartTransform;
+    // each cabin is carried round to its place on the wheel, then turned back the other way so it hangs level
+    for (std::size_t i = 0; i < cabins.size(); i++) {
+        const float offset = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(CABINS);
+        cabins[i]->setLocalTransform(RotateAbout(HUB, offset) * RotateAbout(CABIN_PIVOT, -(offset + angle)));
+    }
 }
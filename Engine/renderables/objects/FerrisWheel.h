@@ -8,11 +8,13 @@
 
 #include "Config.h"
 #include "graphics/Shader.h"
+#include "graphics/buffers/StaticGeometry.h"
 #include <utils/ShaderManager.h>
 
 #include "renderables/Renderable.h"
 #include "graphics/Model.h"
 #include <memory>
+#include <vector>
 #include <glm/ext/matrix_transform.hpp>
 #include <renderables/Entity.h>
 
@@ -24,26 +26,36 @@ public:
 
     void draw(std::shared_ptr<Shader> shader) const override;
 
+    // parts that never move, can be cached in the shadow map
+    void drawStatic(const std::shared_ptr<Shader> &shader) const;
+
+    void drawDynamic(const std::shared_ptr<Shader> &shader) const;
+
     void update(float deltaTime) override;
 
 private:
-    Model staticPart;
-    Model rotatingPart;
-    Model cabin;
+    // model space, the wheel turns about the x axis through the hub
+    static constexpr auto HUB = glm::vec3(0.0F, 4.45F, 0.0F);
+    // the cart is modelled hanging from the top of the wheel, this is the point it hangs from
+    static constexpr auto CABIN_PIVOT = glm::vec3(0.0F, 7.0F, 0.0F);
+    static constexpr int CABINS = 8;
+
+    // the static part is the entity's own model, the wheel is its child and the cabins are the wheel's
+    Entity *wheel = nullptr;
+    std::vector<Entity *> cabins;
+
+    std::shared_ptr<Model> entrance;
 
-    Model entrance;
+    std::vector<StaticGeometry::Part> staticParts;
 
     glm::mat4 staticPartTransform = Config::IDENTITY_MATRIX;
-    glm::mat4 rotatingPartTransform = Config::IDENTITY_MATRIX;
-    glm::mat4 cabinTransform = Config::IDENTITY_MATRIX;
 
     glm::mat4 entranceTransform = Config::IDENTITY_MATRIX;
 
     glm::vec3 scale = glm::vec3(10.0F);
     glm::vec3 translation = glm::vec3(20.0F, 0.0F, 0.0F);
 
-    float radius = 4.45F * scale.y;
-    glm::vec3 centre = glm::vec3(0.0F, radius, 0.0F);
+    float angle = 0.0F;
 };
 
 
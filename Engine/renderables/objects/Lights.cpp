@@ -9,30 +9,32 @@
 //
 
 #include <App.h>
+#include <graphics/buffers/StaticGeometry.h>
 #include <graphics/Model.h>
+#include <utils/AssetManager.h>
 #include <utils/ShaderManager.h>
 #include <vector>
 
 #include "renderables/Renderable.h"
 #include "utils/Lights.h"
 
-LightObjects::LightObjects() : lightModel("../Assets/objects/lights/bulb.obj") {
+LightObjects::LightObjects() : lightModel(
+    AssetManager::GetInstance().getModel("../Assets/objects/lights/bulb.obj")) {
     shader = ShaderManager::GetInstance().get("Untextured");
     pointLights.reserve(16);
 
     setupLights();
+
+    parts = StaticGeometry::GetInstance().add(*lightModel, tranforms);
 }
 
 void LightObjects::draw(const std::shared_ptr<Shader> shader) const {
     shader->use();
-    for (int i = 0; i < 4; i++) {
-        shader->setUniform("model", tranforms[i]);
-        shader->setUniform("color", glm::vec3(1.0F));
-        lightModel.draw(shader);
-    }
+    shader->setUniform("color", glm::vec3(1.0F));
+    StaticGeometry::GetInstance().draw(shader, parts);
 }
 
-[[nodiscard]] auto LightObjects::getPointLights() const -> std::vector<PointLight> {
+[[nodiscard]] auto LightObjects::getPointLights() const -> const std::vector<PointLight> & {
     return pointLights;
 }
 
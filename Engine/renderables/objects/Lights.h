@@ -9,6 +9,7 @@
 #include <graphics/Model.h>
 #include <utils/ShaderManager.h>
 
+#include "graphics/buffers/StaticGeometry.h"
 #include "renderables/Renderable.h"
 #include "utils/Lights.h"
 
@@ -20,7 +21,7 @@ public:
 
     void draw(std::shared_ptr<Shader> shader) const override;
 
-    [[nodiscard]] auto getPointLights() const -> std::vector<PointLight>;
+    [[nodiscard]] auto getPointLights() const -> const std::vector<PointLight> &;
 
     void update(float deltaTime);
 
@@ -28,7 +29,8 @@ private:
     std::array<glm::mat4, 4> tranforms;
     std::vector<PointLight> pointLights;
 
-    Model lightModel;
+    std::shared_ptr<Model> lightModel;
+    std::vector<StaticGeometry::Part> parts;
 
     void setupLights();
 };
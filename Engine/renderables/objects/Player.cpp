@@ -12,6 +12,7 @@
 #include "graphics/Shader.h"
 #include "imgui/imgui.h"
 #include <cmath>
+#include <glm/common.hpp>
 #include <glm/geometric.hpp>
 #include <glm/trigonometric.hpp>
 #include <memory>
@@ -60,6 +61,7 @@ Player::Player(const Mode mode) : Entity("../Assets/objects/person/person2.obj")
             car->setIsPlayer(true);
             box = car->getBoundingBox();
             isDriving = true;
+            attachTo(car.get());
             break;
         case Mode::DRIVE:
             attributes.gravityAffected = false;
@@ -72,6 +74,7 @@ Player::Player(const Mode mode) : Entity("../Assets/objects/person/person2.obj")
             car->setIsPlayer(true);
             box = car->getBoundingBox();
             isDriving = true;
+            attachTo(car.get());
             break;
         case Mode::DUEL:
             attributes.gravityAffected = true;
@@ -179,12 +182,20 @@ void Player::update(const float dt) {
         const auto up = car->attributes.getUp();
         const auto right = car->attributes.getRight();
 
-        attributes.position = pos;
+        // in the seat, or trailing behind. the third person camera stays level, so its height is added after
+        const auto seat = thirdPersonMode ? glm::vec3(0.0F, 0.0F, -30.0F) : glm::vec3(0.0F, 6.0F, -2.0F);
 
-        const glm::vec3 backTranslation = thirdPersonMode ? -front * 30.0F : -front * 2.0F;
-        const auto upTranslation = thirdPersonMode ? glm::vec3(0.0F, 12.0F, 0.0F) : up * 6.0F;
+        // the seat is in world units but the car's matrix carries its model scale, which differs between cars,
+        // so it's divided back out to land the same distance from every car
+        const glm::mat4 parent = car->getWorldTransform();
+        const glm::vec3 scale(glm::length(glm::vec3(parent[0])), glm::length(glm::vec3(parent[1])),
+                              glm::length(glm::vec3(parent[2])));
+        setLocalTransform(glm::translate(Config::IDENTITY_MATRIX, seat / glm::max(scale, glm::vec3(1.0e-6F))));
 
-        attributes.position += backTranslation + upTranslation;
+        attributes.position = glm::vec3(getWorldTransform()[3]);
+        if (thirdPersonMode) {
+            attributes.position.y += 12.0F;
+        }
         camera.setPosition(attributes.position);
 
         const auto angle = glm::acos(glm::dot(front, glm::vec3(0.0F, 0.0F, 1.0F)));
@@ -250,6 +261,7 @@ void Player::startDriving(const bool should) {
         box = car->getBoundingBox();
         isDriving = true;
         car->isCurrentPlayer(true);
+        attachTo(car.get());
     }
 }
 
@@ -272,6 +284,16 @@ auto Player::isThirdPerson() const -> bool {
     return thirdPersonMode;
 }
 
+void Player::isThirdPerson(const bool thirdPerson) {
+    if (mode != Mode::DRIVE && mode != Mode::PATH) {
+        return;
+    }
+
+    thirdPersonMode = thirdPerson;
+    camera.isThirdPerson(thirdPersonMode);
+    car->isThirdPerson(thirdPersonMode);
+}
+
 void Player::collisionResponse() {
     if (car) {
         car->collisionResponse();
@@ -301,19 +323,24 @@ void Player::debug() const {
     ImGui::End();
 }
 
-void Player::interface() {
+auto Player::interface(const bool tuning) -> std::optional<bool> {
+    std::optional<bool> requested;
+
     ImGui::Begin("Player");
+    ImGui::BeginDisabled(!tuning);
     ImGui::SliderFloat("Jump Force", &jumpForce, 0.0F, 10000.0F);
     ImGui::SliderFloat("Mass", &attributes.mass, 0.1F, 1000.0F);
     ImGui::SliderFloat("Speed", &speed, 0.0F, 100.0F);
     ImGui::SliderFloat("Nitro Force", &nitroForce, 0.0F, 1000.0F);
+    ImGui::EndDisabled();
     if (mode == Mode::DRIVE || mode == Mode::PATH) {
-        if (ImGui::Checkbox("Third Person Mode", &thirdPersonMode)) {
-            camera.isThirdPerson(thirdPersonMode);
-            car->isThirdPerson(thirdPersonMode);
+        if (bool thirdPerson = thirdPersonMode; ImGui::Checkbox("Third Person Mode", &thirdPerson)) {
+            requested = thirdPerson;
         }
     }
     ImGui::End();
+
+    return requested;
 }
 
 void Player::nitro() {
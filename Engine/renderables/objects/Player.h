@@ -7,6 +7,7 @@
 
 #include <glm/ext/vector_float3.hpp>
 #include <memory>
+#include <optional>
 
 #include "BumperCar.h"
 #include "graphics/Shader.h"
@@ -47,7 +48,9 @@ public:
 
     void shouldDraw(bool draw);
 
-    void interface();
+    // the third person mode asked for, left to the caller to apply so a replay can record it. tuning false greys
+    // out the sliders
+    [[nodiscard]] auto interface(bool tuning = true) -> std::optional<bool>;
 
     void debug() const;
 
@@ -59,6 +62,8 @@ public:
 
     [[nodiscard]] auto isThirdPerson() const -> bool;
 
+    void isThirdPerson(bool thirdPerson);
+
     void collisionResponse() override;
 
 private:
@@ -8,6 +8,7 @@
 #include "Clouds.h"
 #include "utils/Noise.h"
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <iostream>
 #include <glm/ext/matrix_float4x4.hpp>
@@ -16,28 +17,34 @@
 #include <glm/geometric.hpp>
 #include <memory>
 #include <print>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <graphics/Color.h>
 
+#include "graphics/buffers/StaticGeometry.h"
 #include "graphics/buffers/VertexBuffer.h"
 #include "graphics/Vertex.h"
 #include "graphics/Shader.h"
+#include "utils/FrameArena.h"
 #include "utils/ShaderManager.h"
 #include "utils/PlayerManager.h"
+#include "utils/Profiler.h"
 #include "utils/Random.h"
+#include "utils/StartupTimeline.h"
+#include "App.h"
 
 void ProceduralTerrain::Chunk::init() {
-    buffer = std::make_unique<VertexBuffer>();
-    buffer->fill(vertices, indices);
+    range = StaticGeometry::GetInstance().add(data.vertices, data.indices);
 }
 
 ProceduralTerrain::ProceduralTerrain(const glm::vec2 center, const int chunkSize,
                                      const int numChunksX,
-                                     const int numChunksY)
-    : centre(center), chunkSize(chunkSize), numChunksX(numChunksX), numChunksY(numChunksY) {
+                                     const int numChunksY, const int numTrees, const int numClouds,
+                                     const VertexBuffer::Retention retention)
+    : centre(center), chunkSize(chunkSize), numChunksX(numChunksX), numChunksY(numChunksY), numTrees(numTrees),
+      numClouds(numClouds), retention(retention) {
     shader = ShaderManager::GetInstance().get("Simple");
-    chunks.reserve(static_cast<std::size_t>(numChunksX) * static_cast<std::size_t>(numChunksY));
 
     worldSizeX = static_cast<float>(chunkSize * numChunksX);
     worldSizeY = static_cast<float>(chunkSize * numChunksY);
@@ -65,17 +72,19 @@ void ProceduralTerrain::draw(const std::shared_ptr<Shader> shader) const {
 
     shader->setUniform("model", Config::IDENTITY_MATRIX);
 
+    // rebuilt every draw, so it comes from the frame arena rather than the heap
+    FrameArena::Vector<StaticGeometry::Range> ranges(FrameArena::GetInstance().resource());
+    ranges.reserve(static_cast<std::size_t>(endY - startY) * static_cast<std::size_t>(endX - startX));
 
     for (int i = startY; i < endY; i++) {
         for (int j = startX; j < endX; j++) {
             const std::size_t index = i * numChunksX + j;
-            const auto &chunk = chunks[index];
-
-            chunk.buffer->bind();
-            chunk.buffer->draw();
-            chunk.buffer->unbind();
+            ranges.push_back(chunks[index].range);
         }
     }
+
+    // every visible chunk in one call
+    StaticGeometry::GetInstance().draw(ranges);
 }
 
 void ProceduralTerrain::draw() const {
@@ -191,15 +200,47 @@ ProceduralTerrain::getIntersectionPoint(const glm::vec3 &rayStart, const glm::ve
 }
 
 
-constexpr void ProceduralTerrain::generate() {
-    for (int y = 0; y < numChunksY; y++) {
-        for (int x = 0; x < numChunksX; x++) {
-            generateChunk(x, y);
+void ProceduralTerrain::generate() {
+    chunks.resize(static_cast<std::size_t>(numChunksX) * static_cast<std::size_t>(numChunksY));
+
+    {
+        // the upper bound is kept at one or more, clamp is undefined when it falls below the lower
+        const unsigned int threads = std::clamp(std::thread::hardware_concurrency(), 1U,
+                                                static_cast<unsigned int>(std::max(1, numChunksY)));
+        std::atomic<int> nextRow = 0;
+
+        std::vector<std::jthread> workers;
+        workers.reserve(threads);
+
+        for (unsigned int i = 0; i < threads; i++) {
+            workers.emplace_back([this, &nextRow] {
+                PROFILE_THREAD("Terrain");
+                PROFILE_ZONE("Terrain chunks");
+                const StartupTimeline::Scope scope("Terrain chunks");
+
+                for (int y = nextRow++; y < numChunksY; y = nextRow++) {
+                    for (int x = 0; x < numChunksX; x++) {
+                        chunks[static_cast<std::size_t>(y * numChunksX + x)] = generateChunk(x, y);
+                    }
+                }
+            });
         }
     }
 
+    // the static geometry isn't thread safe, adding in chunk order keeps the same layout as a serial build.
+    // headless the chunks are only needed for their heights, which come from the noise anyway
+    for (auto &chunk: chunks) {
+        if (!App::headless) {
+            chunk.init();
+        }
+
+        VertexBuffer::Retain(chunk.data, retention);
+    }
+
+    // the rest draws from the shared random engine, which has to stay on one thread
+
     std::vector<glm::vec3> treePositions;
-    for (int i = 0; i < NUM_TREE_INSTANCES; i++) {
+    for (int i = 0; i < numTrees; i++) {
         const float x = Random::Float(-worldSizeX / 2.0F, worldSizeX / 2.0F);
         const float z = Random::Float(-worldSizeY / 2.0F, worldSizeY / 2.0F);
         const float y = getTerrainHeight(x, z);
@@ -228,7 +269,7 @@ constexpr void ProceduralTerrain::generate() {
     trees.generateTrees(treePositions);
 
     std::vector<glm::vec3> cloudPositions;
-    for (int i = 0; i < NUM_CLOUD_INSTANCES; i++) {
+    for (int i = 0; i < numClouds; i++) {
         const float x = Random::Float(-worldSizeX / 2.0F, worldSizeX / 2.0F);
         const float z = Random::Float(-worldSizeY / 2.0F, worldSizeY / 2.0F);
         const float y = getTerrainHeight(x, z) + Random::Float(125.0F, 250.0F);
@@ -239,7 +280,7 @@ constexpr void ProceduralTerrain::generate() {
     clouds.generateClouds(cloudPositions);
 }
 
-constexpr void ProceduralTerrain::generateChunk(const int chunkX, const int chunkY) {
+constexpr auto ProceduralTerrain::generateChunk(const int chunkX, const int chunkY) const -> Chunk {
     const int xOffset = chunkX * chunkSize;
     const int yOffset = chunkY * chunkSize;
 
@@ -260,7 +301,7 @@ constexpr void ProceduralTerrain::generateChunk(const int chunkX, const int chun
 
             const float yCoord = getTerrainHeight(xCoord, zCoord);
 
-            chunk.vertices.push_back(Vertex::Data{{xCoord, yCoord, zCoord}});
+            chunk.data.vertices.push_back(Vertex::Data{{xCoord, yCoord, zCoord}});
         }
     }
 
@@ -272,46 +313,46 @@ constexpr void ProceduralTerrain::generateChunk(const int chunkX, const int chun
             const int bottomLeft = j + (i + 1) * (chunkSize + 1);
             const int bottomRight = j + 1 + (i + 1) * (chunkSize + 1);
 
-            chunk.indices.push_back(topLeft);
-            chunk.indices.push_back(bottomLeft);
-            chunk.indices.push_back(topRight);
+            chunk.data.indices.push_back(topLeft);
+            chunk.data.indices.push_back(bottomLeft);
+            chunk.data.indices.push_back(topRight);
 
-            chunk.indices.push_back(topRight);
-            chunk.indices.push_back(bottomLeft);
-            chunk.indices.push_back(bottomRight);
+            chunk.data.indices.push_back(topRight);
+            chunk.data.indices.push_back(bottomLeft);
+            chunk.data.indices.push_back(bottomRight);
         }
     }
 
-    for (std::size_t i = 0; i < chunk.indices.size(); i += 3) {
-        const glm::vec3 v0 = chunk.vertices[chunk.indices[i]].position;
-        const glm::vec3 v1 = chunk.vertices[chunk.indices[i + 1]].position;
-        const glm::vec3 v2 = chunk.vertices[chunk.indices[i + 2]].position;
+    for (std::size_t i = 0; i < chunk.data.indices.size(); i += 3) {
+        const glm::vec3 v0 = chunk.data.vertices[chunk.data.indices[i]].position;
+        const glm::vec3 v1 = chunk.data.vertices[chunk.data.indices[i + 1]].position;
+        const glm::vec3 v2 = chunk.data.vertices[chunk.data.indices[i + 2]].position;
 
         const glm::vec3 normal = glm::normalize(glm::cross(v1 - v0, v2 - v0));
 
-        chunk.vertices[chunk.indices[i]].normal += normal;
-        chunk.vertices[chunk.indices[i + 1]].normal += normal;
-        chunk.vertices[chunk.indices[i + 2]].normal += normal;
+        chunk.data.vertices[chunk.data.indices[i]].normal += normal;
+        chunk.data.vertices[chunk.data.indices[i + 1]].normal += normal;
+        chunk.data.vertices[chunk.data.indices[i + 2]].normal += normal;
     }
 
-    for (auto &vertex: chunk.vertices) {
+    for (auto &vertex: chunk.data.vertices) {
         vertex.normal = glm::normalize(vertex.normal);
     }
 
     // texture coordinates
-    for (auto &vertex: chunk.vertices) {
+    for (auto &vertex: chunk.data.vertices) {
         vertex.texCoords = glm::vec2(vertex.position.x, vertex.position.z);
     }
 
     // tangent and bitangent
-    for (std::size_t i = 0; i < chunk.indices.size(); i += 3) {
-        const glm::vec3 v0 = chunk.vertices[chunk.indices[i]].position;
-        const glm::vec3 v1 = chunk.vertices[chunk.indices[i + 1]].position;
-        const glm::vec3 v2 = chunk.vertices[chunk.indices[i + 2]].position;
+    for (std::size_t i = 0; i < chunk.data.indices.size(); i += 3) {
+        const glm::vec3 v0 = chunk.data.vertices[chunk.data.indices[i]].position;
+        const glm::vec3 v1 = chunk.data.vertices[chunk.data.indices[i + 1]].position;
+        const glm::vec3 v2 = chunk.data.vertices[chunk.data.indices[i + 2]].position;
 
-        const glm::vec2 uv0 = chunk.vertices[chunk.indices[i]].texCoords;
-        const glm::vec2 uv1 = chunk.vertices[chunk.indices[i + 1]].texCoords;
-        const glm::vec2 uv2 = chunk.vertices[chunk.indices[i + 2]].texCoords;
+        const glm::vec2 uv0 = chunk.data.vertices[chunk.data.indices[i]].texCoords;
+        const glm::vec2 uv1 = chunk.data.vertices[chunk.data.indices[i + 1]].texCoords;
+        const glm::vec2 uv2 = chunk.data.vertices[chunk.data.indices[i + 2]].texCoords;
 
         const glm::vec3 deltaPos1 = v1 - v0;
         const glm::vec3 deltaPos2 = v2 - v0;
@@ -324,24 +365,24 @@ constexpr void ProceduralTerrain::generateChunk(const int chunkX, const int chun
         const glm::vec3 tangent = f * (deltaPos1 * deltaUV2.y - deltaPos2 * deltaUV1.y);
         const glm::vec3 bitangent = f * (deltaPos2 * deltaUV1.x - deltaPos1 * deltaUV2.x);
 
-        chunk.vertices[chunk.indices[i]].tangent += tangent;
-        chunk.vertices[chunk.indices[i + 1]].tangent += tangent;
-        chunk.vertices[chunk.indices[i + 2]].tangent += tangent;
+        chunk.data.vertices[chunk.data.indices[i]].tangent += tangent;
+        chunk.data.vertices[chunk.data.indices[i + 1]].tangent += tangent;
+        chunk.data.vertices[chunk.data.indices[i + 2]].tangent += tangent;
 
-        chunk.vertices[chunk.indices[i]].bitangent += bitangent;
-        chunk.vertices[chunk.indices[i + 1]].bitangent += bitangent;
-        chunk.vertices[chunk.indices[i + 2]].bitangent += bitangent;
+        chunk.data.vertices[chunk.data.indices[i]].bitangent += bitangent;
+        chunk.data.vertices[chunk.data.indices[i + 1]].bitangent += bitangent;
+        chunk.data.vertices[chunk.data.indices[i + 2]].bitangent += bitangent;
     }
 
     // height mapping for lod
-    for (std::size_t i = 0; i < chunk.indices.size(); i += 3) {
-        const glm::vec3 v0 = chunk.vertices[chunk.indices[i]].position;
-        const glm::vec3 v1 = chunk.vertices[chunk.indices[i + 1]].position;
-        const glm::vec3 v2 = chunk.vertices[chunk.indices[i + 2]].position;
+    for (std::size_t i = 0; i < chunk.data.indices.size(); i += 3) {
+        const glm::vec3 v0 = chunk.data.vertices[chunk.data.indices[i]].position;
+        const glm::vec3 v1 = chunk.data.vertices[chunk.data.indices[i + 1]].position;
+        const glm::vec3 v2 = chunk.data.vertices[chunk.data.indices[i + 2]].position;
 
-        const glm::vec2 uv0 = chunk.vertices[chunk.indices[i]].texCoords;
-        const glm::vec2 uv1 = chunk.vertices[chunk.indices[i + 1]].texCoords;
-        const glm::vec2 uv2 = chunk.vertices[chunk.indices[i + 2]].texCoords;
+        const glm::vec2 uv0 = chunk.data.vertices[chunk.data.indices[i]].texCoords;
+        const glm::vec2 uv1 = chunk.data.vertices[chunk.data.indices[i + 1]].texCoords;
+        const glm::vec2 uv2 = chunk.data.vertices[chunk.data.indices[i + 2]].texCoords;
 
         const glm::vec3 edge1 = v1 - v0;
         const glm::vec3 edge2 = v2 - v0;
@@ -354,13 +395,12 @@ constexpr void ProceduralTerrain::generateChunk(const int chunkX, const int chun
         const glm::vec3 tangent = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
         const glm::vec3 bitangent = f * (deltaUV1.x * edge2 - deltaUV2.x * edge1);
 
-        const glm::mat3 TBN = glm::mat3(tangent, bitangent, chunk.vertices[chunk.indices[i]].normal);
+        const glm::mat3 TBN = glm::mat3(tangent, bitangent, chunk.data.vertices[chunk.data.indices[i]].normal);
 
-        chunk.vertices[chunk.indices[i]].TBN = TBN;
-        chunk.vertices[chunk.indices[i + 1]].TBN = TBN;
-        chunk.vertices[chunk.indices[i + 2]].TBN = TBN;
+        chunk.data.vertices[chunk.data.indices[i]].TBN = TBN;
+        chunk.data.vertices[chunk.data.indices[i + 1]].TBN = TBN;
+        chunk.data.vertices[chunk.data.indices[i + 2]].TBN = TBN;
     }
 
-    chunk.init();
-    chunks.push_back(std::move(chunk));
+    return chunk;
 }
@@ -10,6 +10,7 @@
 #include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_float3.hpp>
 #include <vector>
+#include "graphics/buffers/StaticGeometry.h"
 #include "graphics/buffers/VertexBuffer.h"
 #include "graphics/Vertex.h"
 #include "graphics/Shader.h"
@@ -25,12 +26,14 @@ constexpr auto DEFAULT_NUM_CHUNKS_X = 16;
 constexpr auto DEFAULT_NUM_CHUNKS_Y = 16;
 constexpr auto NUM_TREE_INSTANCES = 200;
 constexpr auto NUM_CLOUD_INSTANCES = 50;
+// heights come from the noise, so nothing reads a chunk's vertices back once they're baked
+constexpr auto DEFAULT_CHUNK_RETENTION = VertexBuffer::Retention::DISCARD;
 
 class ProceduralTerrain final : public Renderable {
     struct Chunk {
-        std::unique_ptr<VertexBuffer> buffer = nullptr;
-        std::vector<Vertex::Data> vertices;
-        std::vector<GLuint> indices;
+        StaticGeometry::Range range;
+        // the static geometry takes its own copy, this one is kept only as far as the retention says
+        VertexBuffer::Data data;
         glm::vec2 centre = glm::vec2(0.0F, 0.0F);
         int chunkSize = DEFAULT_CHUNK_SIZE;
         Texture::Data normalMap;
@@ -46,7 +49,9 @@ public:
 
     explicit ProceduralTerrain(glm::vec2 center = DEFAULT_CENTRE, int chunkSize = DEFAULT_CHUNK_SIZE,
                                int numChunksX = DEFAULT_NUM_CHUNKS_X,
-                               int numChunksY = DEFAULT_NUM_CHUNKS_Y);
+                               int numChunksY = DEFAULT_NUM_CHUNKS_Y, int numTrees = NUM_TREE_INSTANCES,
+                               int numClouds = NUM_CLOUD_INSTANCES,
+                               VertexBuffer::Retention retention = DEFAULT_CHUNK_RETENTION);
 
     void draw(std::shared_ptr<Shader> shader) const override;
 
@@ -94,12 +99,18 @@ private:
     int numChunksX = DEFAULT_NUM_CHUNKS_X;
     int numChunksY = DEFAULT_NUM_CHUNKS_Y;
 
+    // placement attempts, trees too close to another or to the fair are dropped
+    int numTrees = NUM_TREE_INSTANCES;
+    int numClouds = NUM_CLOUD_INSTANCES;
+    VertexBuffer::Retention retention = DEFAULT_CHUNK_RETENTION;
+
     float worldSizeX;
     float worldSizeY;
 
-    constexpr void generate();
+    void generate();
 
-    constexpr void generateChunk(int chunkX, int chunkY);
+    // pure cpu work, chunks are built on several threads and only added to the static geometry after
+    [[nodiscard]] constexpr auto generateChunk(int chunkX, int chunkY) const -> Chunk;
 
     Trees trees;
     Clouds clouds;
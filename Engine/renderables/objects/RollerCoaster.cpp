@@ -6,25 +6,29 @@
 
 #include "graphics/Model.h"
 #include "graphics/Shader.h"
+#include "utils/AssetManager.h"
 #include "utils/ShaderManager.h"
 #include "renderables/Renderable.h"
 #include <memory>
+#include <span>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 
-RollerCoaster::RollerCoaster() : model("../Assets/objects/rollercoaster/coaster.obj") {
+RollerCoaster::RollerCoaster() : model(
+    AssetManager::GetInstance().getModel("../Assets/objects/rollercoaster/coaster.obj")) {
     modelMatrix = glm::translate(modelMatrix, position);
     modelMatrix = glm::scale(modelMatrix, scale);
     modelMatrix = glm::rotate(modelMatrix, glm::radians(rotation.x), glm::vec3(1.0F, 0.0F, 0.0F));
 
     shader = ShaderManager::GetInstance().get("Base");
+
+    parts = StaticGeometry::GetInstance().add(*model, std::span(&modelMatrix, 1));
 }
 
 void RollerCoaster::draw(const std::shared_ptr<Shader> shader) const {
     shader->use();
-    shader->setUniform("model", modelMatrix);
     shader->setUniform("time", 0.0F);
     shader->setUniform("damage", 0.0F);
-    model.draw(shader);
+    StaticGeometry::GetInstance().draw(shader, parts);
 }
@@ -7,6 +7,7 @@
 
 #include "graphics/Model.h"
 #include "graphics/Shader.h"
+#include "graphics/buffers/StaticGeometry.h"
 #include "utils/ShaderManager.h"
 #include "renderables/Renderable.h"
 #include <memory>
@@ -23,11 +24,12 @@ public:
     void draw(std::shared_ptr<Shader> shader) const override;
 
 private:
-    Model model;
+    std::shared_ptr<Model> model;
     glm::vec3 position = glm::vec3(-400.0F, 0.0F, 50.0F);
     glm::vec3 scale = glm::vec3(4.0F);
     glm::vec3 rotation = glm::vec3(0.0F);
     glm::mat4 modelMatrix = glm::mat4(1.0F);
+    std::vector<StaticGeometry::Part> parts;
 };
 
 
@@ -15,18 +15,42 @@
 #include "renderables/objects/Barriers.h"
 #include <glm/ext/matrix_float4x4.hpp>
 #include <memory>
+#include <string>
+#include <utility>
 #include "renderables/objects/Spotlight.h"
 #include "renderables/objects/Lights.h"
+#include "graphics/buffers/StaticGeometry.h"
+#include "graphics/buffers/VertexBuffer.h"
+#include "Config.h"
+#include "utils/AssetManager.h"
+#include "utils/StartupTimeline.h"
+#include "utils/Profiler.h"
+
+namespace {
+    // constructs one scene object under its own entry in the startup timeline
+    template<typename T, typename... Args>
+    auto Timed(std::string name, Args &&... args) -> std::shared_ptr<T> {
+        const StartupTimeline::Scope scope(std::move(name));
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+}
 
-
-Scene::Scene() {
-    terrain = std::make_shared<ProceduralTerrain>();
-    ferrisWheel = std::make_shared<FerrisWheel>();
-    rollerCoaster = std::make_shared<RollerCoaster>();
-    skybox = std::make_shared<Skybox>();
-    walls = std::make_shared<Walls>();
-    barriers = std::make_shared<Barriers>();
-    lightObjects = std::make_shared<LightObjects>();
+Scene::Scene(const int numChunks, const int numTrees, const int numClouds) {
+    terrain = Timed<ProceduralTerrain>("Terrain", DEFAULT_CENTRE, DEFAULT_CHUNK_SIZE, numChunks, numChunks, numTrees,
+                                       numClouds);
+    ferrisWheel = Timed<FerrisWheel>("Ferris wheel");
+    rollerCoaster = Timed<RollerCoaster>("Roller coaster");
+    skybox = Timed<Skybox>("Skybox");
+    walls = Timed<Walls>("Walls");
+    barriers = Timed<Barriers>("Barriers");
+    lightObjects = Timed<LightObjects>("Lights");
+
+    // everything static has been added by now
+    const StartupTimeline::Scope scope("Static geometry upload");
+    StaticGeometry::GetInstance().upload();
+
+    // nothing can be baked after the upload, and drawing a model only needs what's already on the gpu
+    AssetManager::GetInstance().retain(VertexBuffer::Retention::DISCARD);
 }
 
 void Scene::draw(const glm::mat4 &view, const glm::mat4 &projection) const {
@@ -56,7 +80,21 @@ void Scene::draw() const {
     lightObjects->draw();
 }
 
+void Scene::drawStatic(const std::shared_ptr<Shader> &shader) const {
+    // terrain, ferris wheel frame, roller coaster, barriers and lights all live in the static geometry
+    shader->use();
+    shader->setUniform("model", Config::IDENTITY_MATRIX);
+    StaticGeometry::GetInstance().drawAll();
+}
+
+void Scene::drawDynamic(const std::shared_ptr<Shader> &shader) const {
+    ferrisWheel->drawDynamic(shader);
+    skybox->draw(shader);
+}
+
 void Scene::update(const float deltaTime) const {
+    PROFILE_ZONE("Scene update");
+
     ferrisWheel->update(deltaTime);
     skybox->update(deltaTime);
     lightObjects->update(deltaTime);
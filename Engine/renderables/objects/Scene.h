@@ -23,7 +23,9 @@ class Scene final : public Renderable {
 public:
     using Renderable::draw;
 
-    Scene();
+    // the terrain's size and how many trees and clouds it's dressed with
+    explicit Scene(int numChunks = DEFAULT_NUM_CHUNKS_X, int numTrees = NUM_TREE_INSTANCES,
+                   int numClouds = NUM_CLOUD_INSTANCES);
 
     void draw(const glm::mat4 &view, const glm::mat4 &projection) const override;
 
@@ -31,6 +33,11 @@ public:
 
     void draw() const override;
 
+    // casters that never move, safe to cache in the shadow map
+    void drawStatic(const std::shared_ptr<Shader> &shader) const;
+
+    void drawDynamic(const std::shared_ptr<Shader> &shader) const;
+
     void update(float deltaTime) const;
 
     auto getTerrain() -> std::shared_ptr<ProceduralTerrain>;
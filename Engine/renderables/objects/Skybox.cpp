@@ -18,6 +18,7 @@
 
 Skybox::Skybox() {
     skyBuffer = std::make_unique<VertexBuffer>();
+    skyBuffer->owner = "Skybox";
     skyBuffer->fill(vertices, indices);
 
     shader = ShaderManager::GetInstance().get("Sky");
@@ -7,6 +7,7 @@
 
 #include "utils/Lights.h"
 #include "graphics/Model.h"
+#include "utils/AssetManager.h"
 #include "utils/ShaderManager.h"
 #include "renderables/Renderable.h"
 
@@ -14,7 +15,8 @@ class SpotlightObject final : public Renderable {
 public:
     using Renderable::draw;
 
-    SpotlightObject() : lightModel("../Assets/objects/spotlight/spotlight.obj") {
+    SpotlightObject() : lightModel(
+        AssetManager::GetInstance().getModel("../Assets/objects/spotlight/spotlight.obj")) {
         shader = ShaderManager::GetInstance().get("Base");
 
         setupLight();
@@ -23,7 +25,7 @@ public:
     void draw(const std::shared_ptr<Shader> shader) const override {
         shader->use();
         shader->setUniform("model", transform);
-        lightModel.draw(shader);
+        lightModel->draw(shader);
     }
 
     [[nodiscard]] auto getSpotLight() const -> const SpotLight & {
@@ -32,7 +34,7 @@ public:
 
 private:
     SpotLight spotLight;
-    Model lightModel;
+    std::shared_ptr<Model> lightModel;
     glm::mat4 transform;
 
     void setupLight() {
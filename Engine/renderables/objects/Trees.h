@@ -10,12 +10,12 @@
 
 #include <memory>
 #include <vector>
+#include "graphics/InstanceBatcher.h"
 #include "graphics/Model.h"
 #include "graphics/Shader.h"
 #include "renderables/Renderable.h"
 #include <glm/ext/vector_float3.hpp>
 #include <span>
-#include <GL/glew.h>
 #include "utils/BoundingBox.h"
 
 
@@ -35,11 +35,9 @@ public:
 private
 :
     std::vector<glm::vec3> trees;
-    GLuint instanceVBO = 0;
-    Model model;
+    std::vector<Instance> instances;
+    std::shared_ptr<Model> model;
     std::vector<BoundingBox> boundingBoxes;
-
-    void setupInstanceData();
 };
 
 
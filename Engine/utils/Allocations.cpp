@@ -0,0 +1,343 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#include "Allocations.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <print>
+#include <utility>
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define CW_HAS_BACKTRACE
+#endif
+
+#include "imgui/imgui.h"
+
+namespace Allocations {
+    namespace {
+        constexpr auto TAGS = static_cast<std::size_t>(Tag::COUNT);
+
+        constexpr std::array<const char *, TAGS> NAMES = {
+            "Untagged", "Physics", "Particles", "Rendering", "AI", "Assets"
+        };
+
+        constexpr std::size_t FRAMES = 128;
+        // allocations past the threshold that get a backtrace each frame, the rest are only counted
+        constexpr std::size_t TRACES_PER_FRAME = 8;
+        constexpr int MAX_DEPTH = 16;
+        constexpr std::size_t MAX_SITES = 256;
+
+        constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+        constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+        // in front of every block, so delete knows how much to give back and to which tag
+        struct Header {
+            std::size_t size;
+            Tag tag;
+        };
+
+        constexpr std::size_t HEADER = std::max<std::size_t>(sizeof(Header), __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        static_assert(HEADER % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0, "blocks keep new's alignment");
+
+        struct Counters {
+            std::atomic<std::size_t> frameCount = 0;
+            std::atomic<std::size_t> frameBytes = 0;
+            std::atomic<std::size_t> live = 0;
+            std::atomic<std::size_t> peak = 0;
+            std::atomic<std::size_t> traced = 0;
+        };
+
+        struct Snapshot {
+            std::size_t count = 0;
+            std::size_t bytes = 0;
+        };
+
+        // everything here is used by new before main starts, so none of it can need a constructor to run
+        constinit std::array<Counters, TAGS> counters{};
+        constinit std::atomic<std::size_t> totalLive = 0;
+        constinit std::atomic<std::size_t> totalPeak = 0;
+
+        thread_local Tag current = Tag::UNTAGGED;
+
+        // the last finished frame and a short history of it, main thread only
+        std::array<Snapshot, TAGS> last{};
+        std::array<float, FRAMES> history{};
+        std::size_t frameCount = 0;
+
+#ifdef CW_ALLOCATION_TRACKING
+        // allocations a frame before a tag's alarm goes off, negative never. the per tick paths have been
+        // moved off the heap, so anything there is worth hearing about, loading is expected to allocate
+        constinit std::array<std::atomic<int>, TAGS> thresholds = {-1, 0, 0, 16, 0, -1};
+        constinit std::atomic<bool> armed = true;
+        constinit std::atomic<std::size_t> alarms = 0;
+
+        // call sites already reported, so a steady leak in a loop is only printed the once
+        constinit std::mutex alarmMutex;
+        constinit std::array<std::uint64_t, MAX_SITES> sites{};
+        constinit std::size_t siteCount = 0;
+
+        thread_local bool alarming = false;
+
+        void Raise(std::atomic<std::size_t> &peak, const std::size_t value) {
+            std::size_t seen = peak.load(std::memory_order_relaxed);
+            while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        // true the first time a site is seen
+        auto Remember(const std::uint64_t site) -> bool {
+            if (std::find(sites.begin(), sites.begin() + static_cast<std::ptrdiff_t>(siteCount), site) !=
+                sites.begin() + static_cast<std::ptrdiff_t>(siteCount)) {
+                return false;
+            }
+
+            if (siteCount < MAX_SITES) {
+                sites[siteCount++] = site;
+            }
+
+            return true;
+        }
+
+        void Alarm(const Tag tag, const std::size_t size, const std::size_t count) {
+            // printing allocates too, that shouldn't count against the tag or set this off again
+            alarming = true;
+            const Scope quiet(Tag::UNTAGGED);
+            const std::scoped_lock lock(alarmMutex);
+
+#ifdef CW_HAS_BACKTRACE
+            std::array<void *, MAX_DEPTH> frames{};
+            const int depth = backtrace(frames.data(), MAX_DEPTH);
+
+            std::uint64_t site = FNV_OFFSET;
+            for (int i = 0; i < depth; i++) {
+                site = (site ^ reinterpret_cast<std::uintptr_t>(frames[i])) * FNV_PRIME;
+            }
+#else
+            const auto site = static_cast<std::uint64_t>(tag);
+#endif
+
+            if (Remember(site)) {
+                alarms.fetch_add(1, std::memory_order_relaxed);
+                std::println(stderr, "Unexpected {} allocation of {} bytes, {} this frame, from:", NAMES[
+                                 static_cast<std::size_t>(tag)], size, count);
+
+#ifdef CW_HAS_BACKTRACE
+                // the top frame is this function
+                std::fflush(stderr);
+                backtrace_symbols_fd(frames.data() + 1, depth - 1, fileno(stderr));
+#endif
+            }
+
+            alarming = false;
+        }
+
+        void Record(const Tag tag, const std::size_t size) {
+            const auto index = static_cast<std::size_t>(tag);
+            auto &counter = counters[index];
+
+            const std::size_t count = counter.frameCount.fetch_add(1, std::memory_order_relaxed) + 1;
+            counter.frameBytes.fetch_add(size, std::memory_order_relaxed);
+            Raise(counter.peak, counter.live.fetch_add(size, std::memory_order_relaxed) + size);
+            Raise(totalPeak, totalLive.fetch_add(size, std::memory_order_relaxed) + size);
+
+            if (const int threshold = thresholds[index].load(std::memory_order_relaxed);
+                threshold >= 0 && count > static_cast<std::size_t>(threshold) && !alarming &&
+                armed.load(std::memory_order_relaxed) &&
+                counter.traced.fetch_add(1, std::memory_order_relaxed) < TRACES_PER_FRAME) {
+                Alarm(tag, size, count);
+            }
+        }
+
+        auto Allocate(const std::size_t size) noexcept -> void * {
+            auto *header = static_cast<Header *>(std::malloc(size + HEADER));
+            if (header == nullptr) {
+                return nullptr;
+            }
+
+            header->size = size;
+            header->tag = current;
+            Record(current, size);
+
+            return reinterpret_cast<std::byte *>(header) + HEADER;
+        }
+
+        void Release(void *pointer) noexcept {
+            if (pointer == nullptr) {
+                return;
+            }
+
+            auto *header = reinterpret_cast<Header *>(static_cast<std::byte *>(pointer) - HEADER);
+            counters[static_cast<std::size_t>(header->tag)].live.fetch_sub(header->size, std::memory_order_relaxed);
+            totalLive.fetch_sub(header->size, std::memory_order_relaxed);
+
+            std::free(header);
+        }
+#endif
+
+        auto Kilobytes(const std::size_t bytes) -> float {
+            return static_cast<float>(bytes) / 1024.0F;
+        }
+    }
+
+    Scope::Scope(const Tag tag) noexcept : previous(std::exchange(current, tag)) {
+    }
+
+    Scope::~Scope() {
+        current = previous;
+    }
+
+    void Frame() {
+        std::size_t bytes = 0;
+
+        for (std::size_t i = 0; i < TAGS; i++) {
+            last[i] = {
+                counters[i].frameCount.exchange(0, std::memory_order_relaxed),
+                counters[i].frameBytes.exchange(0, std::memory_order_relaxed)
+            };
+            counters[i].traced.store(0, std::memory_order_relaxed);
+            bytes += last[i].bytes;
+        }
+
+        history[frameCount++ % FRAMES] = Kilobytes(bytes);
+    }
+
+    auto Live() -> std::size_t {
+        return totalLive.load(std::memory_order_relaxed);
+    }
+
+    auto Peak() -> std::size_t {
+        return totalPeak.load(std::memory_order_relaxed);
+    }
+
+    void Interface() {
+        ImGui::Begin("Allocations");
+
+#ifdef CW_ALLOCATION_TRACKING
+        ImGui::Text("Live: %.1f KB, peak %.1f KB", Kilobytes(Live()), Kilobytes(Peak()));
+
+        ImGui::SameLine();
+        if (ImGui::Button("Reset peaks")) {
+            for (auto &counter: counters) {
+                counter.peak.store(counter.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            totalPeak.store(Live(), std::memory_order_relaxed);
+        }
+
+        bool isArmed = armed.load();
+        if (ImGui::Checkbox("Alarms", &isArmed)) {
+            armed.store(isArmed);
+        }
+
+        ImGui::SameLine();
+        ImGui::Text("%zu call sites reported", alarms.load(std::memory_order_relaxed));
+
+        // oldest first
+        std::array<float, FRAMES> ordered{};
+        const std::size_t count = std::min(frameCount, FRAMES);
+        for (std::size_t i = 0; i < count; i++) {
+            ordered[i] = history[(frameCount - count + i) % FRAMES];
+        }
+
+        ImGui::PlotLines("KB per frame", ordered.data(), static_cast<int>(count), 0, nullptr, 0.0F, FLT_MAX,
+                         ImVec2(0.0F, 60.0F));
+
+        if (ImGui::BeginTable("Tags", 6)) {
+            ImGui::TableSetupColumn("Subsystem");
+            ImGui::TableSetupColumn("Allocs");
+            ImGui::TableSetupColumn("KB");
+            ImGui::TableSetupColumn("Live KB");
+            ImGui::TableSetupColumn("Peak KB");
+            // -1 turns a tag's alarm off
+            ImGui::TableSetupColumn("Alarm over");
+            ImGui::TableHeadersRow();
+
+            for (std::size_t i = 0; i < TAGS; i++) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(NAMES[i]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", last[i].count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", Kilobytes(last[i].bytes));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", Kilobytes(counters[i].live.load(std::memory_order_relaxed)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", Kilobytes(counters[i].peak.load(std::memory_order_relaxed)));
+                ImGui::TableNextColumn();
+
+                ImGui::PushID(static_cast<int>(i));
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (int threshold = thresholds[i].load(); ImGui::InputInt("##threshold", &threshold)) {
+                    thresholds[i].store(std::max(threshold, -1));
+                }
+                ImGui::PopID();
+            }
+
+            ImGui::EndTable();
+        }
+#else
+        ImGui::TextUnformatted("Built without CW_ALLOCATION_TRACKING");
+#endif
+
+        ImGui::End();
+    }
+}
+
+#ifdef CW_ALLOCATION_TRACKING
+// the aligned overloads are left to the standard library, they never reach these
+auto operator new(const std::size_t size) -> void * {
+    void *pointer = Allocations::Allocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+auto operator new[](const std::size_t size) -> void * {
+    return ::operator new(size);
+}
+
+auto operator new(const std::size_t size, const std::nothrow_t &) noexcept -> void * {
+    return Allocations::Allocate(size);
+}
+
+auto operator new[](const std::size_t size, const std::nothrow_t &) noexcept -> void * {
+    return Allocations::Allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    Allocations::Release(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    Allocations::Release(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    Allocations::Release(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    Allocations::Release(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    Allocations::Release(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    Allocations::Release(pointer);
+}
+#endif
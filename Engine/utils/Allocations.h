@@ -0,0 +1,64 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_ALLOCATIONS_H
+#define CW_ALLOCATIONS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// counts every global new and delete against whichever subsystem is running on that thread, per frame
+// and live, and complains about allocations where there shouldn't be any. the hooks replace the global
+// operator new and delete, so they only exist with CW_ALLOCATION_TRACKING, and like the profiler it is
+// only meant to be used through the macros
+namespace Allocations {
+    enum class Tag : std::uint8_t {
+        UNTAGGED,
+        PHYSICS,
+        PARTICLES,
+        RENDERING,
+        AI,
+        ASSETS,
+        COUNT,
+    };
+
+    // everything allocated on this thread while it is alive goes to the tag, scopes nest and the innermost wins
+    class Scope {
+    public:
+        explicit Scope(Tag tag) noexcept;
+
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+
+        auto operator=(const Scope &) -> Scope & = delete;
+
+    private:
+        Tag previous;
+    };
+
+    // closes the frame's counts, main thread only
+    void Frame();
+
+    // bytes currently allocated through new, over every tag
+    [[nodiscard]] auto Live() -> std::size_t;
+
+    // the most that has been live at once
+    [[nodiscard]] auto Peak() -> std::size_t;
+
+    void Interface();
+}
+
+#ifdef CW_ALLOCATION_TRACKING
+#define CW_ALLOCATION_CONCAT_INNER(a, b) a##b
+#define CW_ALLOCATION_CONCAT(a, b) CW_ALLOCATION_CONCAT_INNER(a, b)
+#define ALLOCATION_SCOPE(tag) \
+    const Allocations::Scope CW_ALLOCATION_CONCAT(allocationScope, __LINE__)(Allocations::Tag::tag)
+#define ALLOCATION_FRAME() Allocations::Frame()
+#else
+#define ALLOCATION_SCOPE(tag) static_cast<void>(0)
+#define ALLOCATION_FRAME() static_cast<void>(0)
+#endif
+
+#endif //CW_ALLOCATIONS_H
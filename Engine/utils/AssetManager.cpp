@@ -0,0 +1,150 @@
+//
+// Created by Jacob Edwards on 18/05/2024.
+//
+
+#include "AssetManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Allocations.h"
+#include "graphics/Model.h"
+#include "graphics/buffers/VertexBuffer.h"
+#include "imgui/imgui.h"
+#include "Profiler.h"
+#include "StartupTimeline.h"
+#include "TextureManager.h"
+
+auto AssetManager::getModel(const std::filesystem::path &path) -> std::shared_ptr<Model> {
+    ALLOCATION_SCOPE(ASSETS);
+    const auto key = Key(path);
+
+    if (const auto it = models.find(key); it != models.end()) {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+
+    auto model = std::make_shared<Model>(path);
+    model->retain(retention);
+    models.emplace(key, model);
+    return model;
+}
+
+void AssetManager::preload(const std::span<const std::filesystem::path> paths) {
+    ALLOCATION_SCOPE(ASSETS);
+    std::vector<std::filesystem::path> pending;
+
+    for (const auto &path: paths) {
+        if (const auto key = Key(path); !models.contains(key) && std::ranges::find(pending, key) == pending.end()) {
+            pending.push_back(key);
+        }
+    }
+
+    if (pending.empty()) {
+        return;
+    }
+
+    std::vector<Model::Import> imports(pending.size());
+    std::atomic<std::size_t> next = 0;
+
+    {
+        const unsigned int threads = std::clamp(std::thread::hardware_concurrency(), 1U,
+                                                static_cast<unsigned int>(pending.size()));
+
+        std::vector<std::jthread> workers;
+        workers.reserve(threads);
+
+        // models vary a lot in size, so workers take the next path as they finish rather than a fixed share
+        for (unsigned int i = 0; i < threads; i++) {
+            workers.emplace_back([&] {
+                PROFILE_THREAD("Model loader");
+
+                for (std::size_t index = next++; index < pending.size(); index = next++) {
+                    imports[index] = Model::Read(pending[index]);
+                }
+            });
+        }
+    }
+
+    // gl only works on this thread, but all that's left is the uploads
+    for (std::size_t i = 0; i < pending.size(); i++) {
+        PROFILE_ZONE("Model upload");
+        const StartupTimeline::Scope scope("Upload " + pending[i].filename().string());
+
+        misses++;
+        const auto model = std::make_shared<Model>(std::move(imports[i]));
+        model->retain(retention);
+        models.emplace(pending[i], model);
+    }
+}
+
+auto AssetManager::isLoaded(const std::filesystem::path &path) const -> bool {
+    return models.contains(Key(path));
+}
+
+auto AssetManager::collect() -> std::size_t {
+    const auto freed = std::erase_if(models, [](const auto &entry) {
+        return entry.second.use_count() == 1;
+    });
+
+    // the freed models were holding their textures
+    TextureManager::GetInstance().collect();
+
+    return freed;
+}
+
+void AssetManager::retain(const VertexBuffer::Retention policy) {
+    retention = policy;
+
+    for (const auto &model: models | std::views::values) {
+        model->retain(policy);
+    }
+}
+
+void AssetManager::interface() {
+    ImGui::Begin("Asset Manager");
+    ImGui::Text("Models: %zu", models.size());
+    ImGui::Text("Hits: %zu, Loads: %zu", hits, misses);
+
+    if (ImGui::Button("Free unused")) {
+        collect();
+    }
+
+    if (ImGui::BeginTable("Models", 3)) {
+        ImGui::TableSetupColumn("Path");
+        ImGui::TableSetupColumn("Handles");
+        ImGui::TableSetupColumn("Meshes");
+        ImGui::TableHeadersRow();
+
+        for (const auto &[path, model]: models) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(path.filename().string().c_str());
+            ImGui::TableNextColumn();
+            // the manager's own reference isn't a consumer
+            ImGui::Text("%ld", model.use_count() - 1);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", model->getMeshes().size());
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+auto AssetManager::Key(const std::filesystem::path &path) -> std::filesystem::path {
+    // "../Assets/a/../b.obj" and "../Assets/b.obj" are the same model
+    return path.lexically_normal();
+}
@@ -0,0 +1,54 @@
+//
+// Created by Jacob Edwards on 18/05/2024.
+//
+
+#ifndef CW_ASSETMANAGER_H
+#define CW_ASSETMANAGER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <unordered_map>
+
+#include "graphics/Model.h"
+#include "graphics/buffers/VertexBuffer.h"
+#include "Singleton.h"
+
+// one model per path for the whole app. handles are shared pointers, so the use count is the
+// number of consumers, and a model stays loaded until collect finds nothing else holding it
+class AssetManager final : public Singleton<AssetManager> {
+public:
+    explicit AssetManager(Token) {
+    }
+
+    // loads from disk only the first time a path is asked for
+    auto getModel(const std::filesystem::path &path) -> std::shared_ptr<Model>;
+
+    // imports every path not already loaded across worker threads, then builds the models on this one.
+    // later getModel calls for these paths are hits
+    void preload(std::span<const std::filesystem::path> paths);
+
+    [[nodiscard]] auto isLoaded(const std::filesystem::path &path) const -> bool;
+
+    // frees every model no consumer holds a handle to, returns how many went
+    auto collect() -> std::size_t;
+
+    // applied to every loaded model and to the ones loaded from now on
+    void retain(VertexBuffer::Retention policy);
+
+    void interface();
+
+private:
+    std::unordered_map<std::filesystem::path, std::shared_ptr<Model> > models;
+
+    VertexBuffer::Retention retention = VertexBuffer::Retention::KEEP;
+
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+
+    static auto Key(const std::filesystem::path &path) -> std::filesystem::path;
+};
+
+
+#endif //CW_ASSETMANAGER_H
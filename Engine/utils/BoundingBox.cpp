@@ -182,8 +182,8 @@ void BoundingBox::rotate(const glm::vec3 &axis, const float angle) {
     */
 }
 
-auto BoundingBox::getCorners() const -> std::vector<glm::vec3> {
-    std::vector<glm::vec3> corners(8);
+auto BoundingBox::getCorners() const -> std::array<glm::vec3, 8> {
+    std::array<glm::vec3, 8> corners;
 
     for (int i = 0; i < 8; ++i) {
         corners[i] = {
@@ -288,6 +288,7 @@ void BoundingBox::expand(const BoundingBox &other) {
 void BoundingBox::initBuffer() {
     buffer = std::make_unique<VertexBuffer>();
     buffer->drawMode = GL_LINES;
+    buffer->owner = "Bounding boxes";
 
     const std::vector<Vertex::Data> vertices = {
         {{min.x, min.y, min.z}, {0.0F, 0.0F, 0.0F}, {0.0F, 0.0F}},
@@ -323,6 +324,7 @@ void BoundingBox::draw(const std::shared_ptr<Shader> shader) const {
     shader->setUniform("model", Config::IDENTITY_MATRIX);
     const auto buffer = std::make_unique<VertexBuffer>();
     buffer->drawMode = GL_LINES;
+    buffer->owner = "Bounding boxes";
 
     std::vector<Vertex::Data> vertices = {
         {{min.x, min.y, min.z}, {0.0F, 0.0F, 0.0F}, {0.0F, 0.0F}},
@@ -10,6 +10,7 @@
 #include <glm/ext/vector_float3.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
 
+#include <array>
 #include <utility>
 #include <vector>
 #include <memory>
@@ -78,7 +79,7 @@ public:
 
     void rotate(const glm::vec3 &rotation);
 
-    [[nodiscard]] auto getCorners() const -> std::vector<glm::vec3>;
+    [[nodiscard]] auto getCorners() const -> std::array<glm::vec3, 8>;
 
     [[nodiscard]] auto getOffset(const glm::vec3 &point) const -> glm::vec3;
 
@@ -5,6 +5,7 @@
 #include "Camera.h"
 #include <array>
 #include <cmath>
+#include <cstddef>
 
 #include <algorithm>
 #include <glm/matrix.hpp>
@@ -65,6 +66,24 @@ auto Camera::getFrustumCorners() const -> std::array<glm::vec3, 4> {
     return corners;
 }
 
+auto Camera::getFrustumCorners(const float near, const float far) const -> std::array<glm::vec3, 8> {
+    const auto view = getViewMatrix();
+    const auto projection = glm::perspective(glm::radians(zoom), aspect, near, far);
+
+    const auto inverseViewProjection = inverse(projection * view);
+
+    std::array<glm::vec3, 8> corners{};
+
+    for (int i = 0; i < 8; i++) {
+        const auto corner = glm::vec4((i & 1) != 0 ? 1.0F : -1.0F, (i & 2) != 0 ? 1.0F : -1.0F,
+                                      (i & 4) != 0 ? 1.0F : -1.0F, 1.0F);
+        const auto worldSpace = inverseViewProjection * corner;
+        corners[i] = glm::vec3(worldSpace) / worldSpace.w;
+    }
+
+    return corners;
+}
+
 auto Camera::getLightViewMatrix(const glm::vec3 lightDirection) const -> glm::mat4 {
     auto centre = glm::vec3(0.0F);
 
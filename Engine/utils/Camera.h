@@ -8,7 +8,10 @@
 #ifndef CW_CAMERA_H
 #define CW_CAMERA_H
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <glm/ext/matrix_float4x4.hpp>
 #include <glm/ext/vector_float3.hpp>
 
@@ -51,6 +54,14 @@ public:
 
     [[nodiscard]] auto getFrustumCorners() const -> std::array<glm::vec3, 4>;
 
+    // world space corners of the slice of the view frustum between near and far
+    [[nodiscard]] auto getFrustumCorners(float near, float far) const -> std::array<glm::vec3, 8>;
+
+    // practical split scheme, blends logarithmic and uniform splits by lambda. asked for every frame, so the
+    // count is fixed and the splits come back by value
+    template<std::size_t Count>
+    [[nodiscard]] auto getCascadeSplits(float lambda, float distance) const -> std::array<float, Count + 1>;
+
     [[nodiscard]] auto getLightViewMatrix(glm::vec3 lightDirection) const -> glm::mat4;
 
     void processMouseMovement(float xOffset, float yOffset);
@@ -172,4 +183,19 @@ private:
     void updateOrbitPosition();
 };
 
+template<std::size_t Count>
+auto Camera::getCascadeSplits(const float lambda, const float distance) const -> std::array<float, Count + 1> {
+    const float far = std::min(distance, renderDistance);
+    std::array<float, Count + 1> splits{};
+
+    for (std::size_t i = 0; i <= Count; i++) {
+        const float fraction = static_cast<float>(i) / static_cast<float>(Count);
+        const float logSplit = nearPlane * std::pow(far / nearPlane, fraction);
+        const float uniformSplit = nearPlane + (far - nearPlane) * fraction;
+        splits[i] = lambda * logSplit + (1.0F - lambda) * uniformSplit;
+    }
+
+    return splits;
+}
+
 #endif // CW_CAMERA_H
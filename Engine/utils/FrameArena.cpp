@@ -0,0 +1,80 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include "imgui/imgui.h"
+
+FrameArena::FrameArena(Token) {
+}
+
+void FrameArena::swap() {
+    const Buffer &finished = buffers[current];
+    lastUsed = finished.getUsed();
+    lastOverflow = finished.getOverflow();
+    peak = std::max(peak, lastUsed + lastOverflow);
+
+    current = 1 - current;
+    buffers[current].reset();
+}
+
+auto FrameArena::resource() -> std::pmr::memory_resource * {
+    return &buffers[current];
+}
+
+void FrameArena::interface() const {
+    ImGui::Begin("Frame Arena");
+    ImGui::Text("Last frame: %.1f KB of %.1f KB", static_cast<float>(lastUsed) / 1024.0F,
+                static_cast<float>(CAPACITY) / 1024.0F);
+    ImGui::Text("Peak: %.1f KB", static_cast<float>(peak) / 1024.0F);
+
+    // anything here went to the general heap, the capacity wants raising
+    if (lastOverflow > 0) {
+        ImGui::TextColored(ImVec4(1.0F, 0.4F, 0.4F, 1.0F), "Overflow: %.1f KB",
+                           static_cast<float>(lastOverflow) / 1024.0F);
+    }
+
+    ImGui::End();
+}
+
+FrameArena::Buffer::Buffer() : memory(std::make_unique<std::byte[]>(CAPACITY)) {
+}
+
+void FrameArena::Buffer::reset() {
+    used = 0;
+    overflow = 0;
+}
+
+auto FrameArena::Buffer::do_allocate(const std::size_t bytes, const std::size_t alignment) -> void * {
+    const auto base = reinterpret_cast<std::uintptr_t>(memory.get());
+    const std::uintptr_t start = (base + used + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+    if (start + bytes <= base + CAPACITY) {
+        used = start + bytes - base;
+        return reinterpret_cast<void *>(start);
+    }
+
+    overflow += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::Buffer::do_deallocate(void *pointer, const std::size_t bytes, const std::size_t alignment) {
+    // arena memory is only ever given back all at once, by reset
+    if (const auto *address = static_cast<std::byte *>(pointer);
+        address >= memory.get() && address < memory.get() + CAPACITY) {
+        return;
+    }
+
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+auto FrameArena::Buffer::do_is_equal(const memory_resource &other) const noexcept -> bool {
+    return this == &other;
+}
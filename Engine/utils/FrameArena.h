@@ -0,0 +1,73 @@
+//
+// Created by Jacob Edwards on 23/05/2024.
+//
+
+#ifndef CW_FRAMEARENA_H
+#define CW_FRAMEARENA_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "Singleton.h"
+
+// bump allocation for data that only lives for a frame. there are two buffers taking turns, the one
+// filled last frame is left alone for a frame so anything still pointing into it stays valid until the
+// next swap. main thread only, the workers keep their own memory
+class FrameArena final : public Singleton<FrameArena> {
+public:
+    template<typename T>
+    using Vector = std::pmr::vector<T>;
+
+    using String = std::pmr::string;
+
+    // bytes in each of the two buffers
+    static constexpr std::size_t CAPACITY = 1U << 20U;
+
+    explicit FrameArena(Token);
+
+    // starts a new frame, everything allocated the frame before last is gone after this
+    void swap();
+
+    // hand this to a pmr container, or wrap it in a std::pmr::polymorphic_allocator
+    [[nodiscard]] auto resource() -> std::pmr::memory_resource *;
+
+    void interface() const;
+
+private:
+    class Buffer final : public std::pmr::memory_resource {
+    public:
+        Buffer();
+
+        void reset();
+
+        [[nodiscard]] auto getUsed() const -> std::size_t { return used; }
+
+        [[nodiscard]] auto getOverflow() const -> std::size_t { return overflow; }
+
+    private:
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t used = 0;
+        // bytes that didn't fit and went to the general heap instead
+        std::size_t overflow = 0;
+
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override;
+
+        void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+
+        [[nodiscard]] auto do_is_equal(const memory_resource &other) const noexcept -> bool override;
+    };
+
+    std::array<Buffer, 2> buffers;
+    std::size_t current = 0;
+
+    // the last finished frame, for the interface
+    std::size_t lastUsed = 0;
+    std::size_t lastOverflow = 0;
+    std::size_t peak = 0;
+};
+
+#endif //CW_FRAMEARENA_H
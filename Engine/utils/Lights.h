@@ -3,27 +3,34 @@
 //
 /*
  *https://learnopengl.com/Lighting/Multiple-lights
+ *https://learnopengl.com/Advanced-OpenGL/Advanced-GLSL
  */
 
 #ifndef LIGHTS_H
 #define LIGHTS_H
 
+#include <cstddef>
 #include <glm/glm.hpp>
 
-constexpr int MAX_POINT_LIGHTS = 12;
+// binding point of the Lights uniform block in lights.glsl
+constexpr unsigned int LIGHTS_BINDING = 1;
+
+// these structs are uploaded as-is to the std140 Lights block, so every vec3 starts on a 16 byte
+// boundary and any trailing float packs into the last 4 bytes of the vec3 before it.
+// point lights live in a texture buffer instead, read back as five vec4s each by lights.glsl
 
 struct DirectionalLight {
-    glm::vec3 direction;
-    glm::vec3 ambient;
-    glm::vec3 diffuse;
-    glm::vec3 specular;
+    alignas(16) glm::vec3 direction;
+    alignas(16) glm::vec3 ambient;
+    alignas(16) glm::vec3 diffuse;
+    alignas(16) glm::vec3 specular;
 };
 
 struct PointLight {
-    glm::vec3 position;
-    glm::vec3 ambient;
-    glm::vec3 diffuse;
-    glm::vec3 specular;
+    alignas(16) glm::vec3 position;
+    alignas(16) glm::vec3 ambient;
+    alignas(16) glm::vec3 diffuse;
+    alignas(16) glm::vec3 specular;
 
     float constant;
     float linear;
@@ -31,11 +38,11 @@ struct PointLight {
 };
 
 struct SpotLight {
-    glm::vec3 position;
-    glm::vec3 direction;
-    glm::vec3 ambient;
-    glm::vec3 diffuse;
-    glm::vec3 specular;
+    alignas(16) glm::vec3 position;
+    alignas(16) glm::vec3 direction;
+    alignas(16) glm::vec3 ambient;
+    alignas(16) glm::vec3 diffuse;
+    alignas(16) glm::vec3 specular;
 
     float constant;
     float linear;
@@ -47,11 +54,32 @@ struct SpotLight {
 
 struct Lights {
     DirectionalLight sun;
-    PointLight pointLight[MAX_POINT_LIGHTS];
-    int pointLightCount;
     SpotLight spotLight;
+
+    // x, y, z cluster counts and the total number of point lights
+    glm::uvec4 clusterGrid;
+    // near, far, slice scale, slice bias
+    glm::vec4 clusterDepth;
+    glm::vec2 screenSize;
 };
 
+static_assert(sizeof(DirectionalLight) == 64);
+static_assert(offsetof(DirectionalLight, specular) == 48);
 
-#endif //LIGHTS_H
+static_assert(sizeof(PointLight) == 5 * sizeof(glm::vec4));
+static_assert(offsetof(PointLight, specular) == 48);
+static_assert(offsetof(PointLight, constant) == 60);
+static_assert(offsetof(PointLight, quadratic) == 68);
+
+static_assert(sizeof(SpotLight) == 96);
+static_assert(offsetof(SpotLight, specular) == 64);
+static_assert(offsetof(SpotLight, constant) == 76);
+static_assert(offsetof(SpotLight, outerCutOff) == 92);
 
+static_assert(offsetof(Lights, spotLight) == 64);
+static_assert(offsetof(Lights, clusterGrid) == 160);
+static_assert(offsetof(Lights, clusterDepth) == 176);
+static_assert(offsetof(Lights, screenSize) == 192);
+
+
+#endif //LIGHTS_H
@@ -12,6 +12,9 @@
 #include <print>
 #include <string>
 #include <ranges>
+#include <iterator>
+#include <optional>
+#include <vector>
 
 
 void PlayerManager::draw(const glm::mat4 &view, const glm::mat4 &projection) const {
@@ -131,16 +134,29 @@ void PlayerManager::clear() {
     players.clear();
 }
 
-void PlayerManager::interface() {
+auto PlayerManager::interface() const -> std::optional<std::string> {
+    std::optional<std::string> picked;
+
     ImGui::Begin("Players");
 
     for (const auto &[name, player]: players) {
         if (ImGui::RadioButton(name.c_str(), currentPlayer == player)) {
-            setCurrent(name);
+            picked = name;
         }
     }
 
     ImGui::End();
+
+    return picked;
+}
+
+auto PlayerManager::getNames() const -> std::vector<std::string> {
+    std::vector<std::string> names;
+    names.reserve(players.size());
+    std::ranges::copy(players | std::views::keys, std::back_inserter(names));
+    std::ranges::sort(names);
+
+    return names;
 }
 
 void PlayerManager::setAspect(float aspect) {
@@ -7,8 +7,10 @@
 #include <glm/ext/matrix_float4x4.hpp>
 #include <memory.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "utils/Singleton.h"
 
 class PlayerManager final : public Singleton<PlayerManager>, public Renderable {
@@ -48,7 +50,11 @@ public:
 
     void setAspect(float aspect);
 
-    void interface();
+    // the player picked this frame, switching is left to the caller so a replay can record it
+    [[nodiscard]] auto interface() const -> std::optional<std::string>;
+
+    // every player's name in a fixed order, a replay stores the index into this
+    [[nodiscard]] auto getNames() const -> std::vector<std::string>;
 
 private:
     std::unordered_map<std::string, std::shared_ptr<Player> > players;
@@ -0,0 +1,375 @@
+//
+// Created by Jacob Edwards on 20/05/2024.
+//
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "imgui/imgui.h"
+#include "StartupTimeline.h"
+
+namespace Profiler {
+    namespace {
+        // a few hundred frames of the main thread at the zone counts we have
+        constexpr std::size_t ZONES_PER_THREAD = 16384;
+        constexpr std::size_t FRAMES = 256;
+
+        struct ThreadBuffer {
+            // only ever contended while the panel or an export is reading
+            std::mutex mutex;
+            std::vector<Zone> zones = std::vector<Zone>(ZONES_PER_THREAD);
+            // total ever written, the ring index is this modulo the size
+            std::size_t written = 0;
+            std::uint32_t depth = 0;
+            std::size_t id = 0;
+            const char *name = nullptr;
+            bool active = true;
+        };
+
+        const Clock::time_point epoch = Clock::now();
+
+        std::atomic<bool> recording = true;
+
+        // buffers outlive their threads so a trace still has the loaders in it. short lived threads, such
+        // as the per frame workers, pick up a buffer some finished thread left behind
+        std::mutex registryMutex;
+        std::vector<std::unique_ptr<ThreadBuffer> > buffers;
+
+        std::array<std::int64_t, FRAMES> frames{};
+        std::size_t frameCount = 0;
+
+        int selectedFrame = 0;
+        std::string exported;
+
+        auto Now() -> std::int64_t {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+        }
+
+        auto Acquire() -> ThreadBuffer * {
+            const std::scoped_lock lock(registryMutex);
+
+            for (const auto &buffer: buffers) {
+                if (!buffer->active) {
+                    buffer->active = true;
+                    buffer->name = nullptr;
+                    return buffer.get();
+                }
+            }
+
+            auto &buffer = buffers.emplace_back(std::make_unique<ThreadBuffer>());
+            buffer->id = buffers.size() - 1;
+            return buffer.get();
+        }
+
+        // hands the buffer back when its thread exits
+        struct Registration {
+            ThreadBuffer *buffer = Acquire();
+
+            ~Registration() {
+                const std::scoped_lock lock(registryMutex);
+                buffer->active = false;
+            }
+        };
+
+        auto Local() -> ThreadBuffer & {
+            thread_local Registration registration;
+            return *registration.buffer;
+        }
+
+        auto ThreadName(const ThreadBuffer &buffer) -> std::string {
+            return buffer.name != nullptr ? buffer.name : "Worker " + std::to_string(buffer.id);
+        }
+
+        // zones that overlap [begin, end), oldest first
+        auto Collect(ThreadBuffer &buffer, const std::int64_t begin, const std::int64_t end) -> std::vector<Zone> {
+            const std::scoped_lock lock(buffer.mutex);
+
+            std::vector<Zone> zones;
+            const std::size_t count = std::min(buffer.written, ZONES_PER_THREAD);
+
+            for (std::size_t i = buffer.written - count; i < buffer.written; i++) {
+                const auto &zone = buffer.zones[i % ZONES_PER_THREAD];
+                if (zone.end > begin && zone.start < end) {
+                    zones.push_back(zone);
+                }
+            }
+
+            return zones;
+        }
+
+        auto Escape(const std::string_view text) -> std::string {
+            std::string escaped;
+            escaped.reserve(text.size());
+
+            for (const char c: text) {
+                if (c == '"' || c == '\\') {
+                    escaped.push_back('\\');
+                }
+                escaped.push_back(c);
+            }
+
+            return escaped;
+        }
+
+        auto ZoneColor(const char *name) -> ImU32 {
+            const auto hash = std::hash<const void *>{}(name);
+            const float hue = static_cast<float>(hash % 360U) / 360.0F;
+            return ImColor::HSV(hue, 0.45F, 0.75F);
+        }
+
+        void DrawThread(const ThreadBuffer &buffer, const std::vector<Zone> &zones, const std::int64_t begin,
+                        const std::int64_t end) {
+            constexpr float rowHeight = 18.0F;
+
+            std::uint32_t depth = 0;
+            for (const auto &zone: zones) {
+                depth = std::max(depth, zone.depth);
+            }
+
+            ImGui::TextUnformatted(ThreadName(buffer).c_str());
+
+            const float width = std::max(ImGui::GetContentRegionAvail().x, 100.0F);
+            const float scale = width / static_cast<float>(end - begin);
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            ImDrawList *drawList = ImGui::GetWindowDrawList();
+
+            for (const auto &zone: zones) {
+                const float left = static_cast<float>(std::max(zone.start, begin) - begin) * scale;
+                const float right = static_cast<float>(std::min(zone.end, end) - begin) * scale;
+
+                const ImVec2 min{origin.x + left, origin.y + static_cast<float>(zone.depth) * rowHeight};
+                const ImVec2 max{origin.x + std::max(right, left + 1.0F), min.y + rowHeight - 1.0F};
+
+                drawList->AddRectFilled(min, max, ZoneColor(zone.name));
+
+                // only label bars wide enough to read
+                if (max.x - min.x > 40.0F) {
+                    const ImVec4 clip{min.x, min.y, max.x, max.y};
+                    drawList->AddText(nullptr, 0.0F, ImVec2(min.x + 2.0F, min.y + 2.0F), IM_COL32_BLACK, zone.name,
+                                      nullptr, 0.0F, &clip);
+                }
+
+                if (ImGui::IsMouseHoveringRect(min, max)) {
+                    ImGui::SetTooltip("%s\n%.3f ms", zone.name, static_cast<float>(zone.end - zone.start) / 1.0e6F);
+                }
+            }
+
+            ImGui::Dummy(ImVec2(width, static_cast<float>(depth + 1) * rowHeight));
+        }
+    }
+
+    Scope::Scope(const char *name) noexcept : name(name), start(Now()) {
+        Local().depth++;
+    }
+
+    Scope::~Scope() {
+        const auto end = Now();
+        auto &buffer = Local();
+        buffer.depth--;
+
+        if (!recording.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        const std::scoped_lock lock(buffer.mutex);
+        buffer.zones[buffer.written % ZONES_PER_THREAD] = {name, start, end, buffer.depth};
+        buffer.written++;
+    }
+
+    void Frame() {
+        if (!recording.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        frames[frameCount % FRAMES] = Now();
+        frameCount++;
+    }
+
+    void SetThreadName(const char *name) {
+        Local().name = name;
+    }
+
+    auto Export(const std::filesystem::path &path) -> bool {
+        std::ofstream file(path);
+        if (!file) {
+            std::println(stderr, "Could not write trace {}", path.string());
+            return false;
+        }
+
+        // chrome wants microseconds
+        const auto micros = [](const std::int64_t nanos) {
+            return static_cast<double>(nanos) / 1000.0;
+        };
+
+        file << R"({"displayTimeUnit":"ms","traceEvents":[)";
+        bool first = true;
+
+        const auto separator = [&] {
+            if (!first) {
+                file << ',';
+            }
+            first = false;
+        };
+
+        {
+            const std::scoped_lock lock(registryMutex);
+
+            for (const auto &buffer: buffers) {
+                separator();
+                std::print(file, R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+                           buffer->id, Escape(ThreadName(*buffer)));
+
+                const std::scoped_lock bufferLock(buffer->mutex);
+                const std::size_t count = std::min(buffer->written, ZONES_PER_THREAD);
+
+                for (std::size_t i = buffer->written - count; i < buffer->written; i++) {
+                    const auto &[name, start, end, depth] = buffer->zones[i % ZONES_PER_THREAD];
+                    separator();
+                    std::print(file, R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                               Escape(name), buffer->id, micros(start), micros(end - start));
+                }
+            }
+        }
+
+        const std::size_t count = std::min(frameCount, FRAMES);
+        for (std::size_t i = frameCount - count; i < frameCount; i++) {
+            separator();
+            std::print(file, R"({{"name":"Frame","ph":"i","s":"g","pid":1,"tid":0,"ts":{:.3f}}})",
+                       micros(frames[i % FRAMES]));
+        }
+
+        // the startup timeline has its own origin and names, it goes in as a second process
+        const auto &startup = StartupTimeline::GetInstance();
+        const auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(startup.getOrigin() - epoch).count();
+
+        for (const auto &[name, lane, start, end]: startup.getEvents()) {
+            separator();
+            std::print(file, R"({{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", Escape(name),
+                       lane, micros(offset) + static_cast<double>(start) * 1000.0,
+                       static_cast<double>(end - start) * 1000.0);
+        }
+
+        file << "]}\n";
+        return true;
+    }
+
+    void Interface() {
+        ImGui::Begin("Profiler");
+
+#ifdef CW_PROFILING
+        bool isRecording = recording.load();
+        if (ImGui::Checkbox("Recording", &isRecording)) {
+            recording.store(isRecording);
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Export trace")) {
+            exported = Export("profile.json") ? "Wrote profile.json" : "Export failed";
+        }
+
+        if (!exported.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(exported.c_str());
+        }
+
+        // frame n runs from its marker to the next one, so the newest marker has no frame yet
+        const std::size_t complete = std::min(frameCount, FRAMES) > 0 ? std::min(frameCount, FRAMES) - 1 : 0;
+        if (complete == 0) {
+            ImGui::TextUnformatted("No frames yet");
+            ImGui::End();
+            return;
+        }
+
+        std::vector<float> durations(complete);
+        for (std::size_t i = 0; i < complete; i++) {
+            const std::size_t frame = frameCount - 1 - complete + i;
+            durations[i] = static_cast<float>(frames[(frame + 1) % FRAMES] - frames[frame % FRAMES]) / 1.0e6F;
+        }
+
+        ImGui::PlotLines("Frame ms", durations.data(), static_cast<int>(durations.size()), 0, nullptr, 0.0F,
+                         *std::ranges::max_element(durations), ImVec2(0.0F, 60.0F));
+
+        // counted back from the newest complete frame, pause recording to look through the history
+        selectedFrame = std::clamp(selectedFrame, 0, static_cast<int>(complete) - 1);
+        ImGui::SliderInt("Frames ago", &selectedFrame, 0, static_cast<int>(complete) - 1);
+
+        const std::size_t frame = frameCount - 2 - static_cast<std::size_t>(selectedFrame);
+        const std::int64_t begin = frames[frame % FRAMES];
+        const std::int64_t end = frames[(frame + 1) % FRAMES];
+        ImGui::Text("Frame %zu: %.3f ms", frame, static_cast<float>(end - begin) / 1.0e6F);
+
+        struct Total {
+            float milliseconds = 0.0F;
+            std::size_t calls = 0;
+        };
+
+        std::unordered_map<const char *, Total> totals;
+
+        {
+            const std::scoped_lock lock(registryMutex);
+
+            for (const auto &buffer: buffers) {
+                const auto zones = Collect(*buffer, begin, end);
+                if (zones.empty()) {
+                    continue;
+                }
+
+                DrawThread(*buffer, zones, begin, end);
+
+                for (const auto &zone: zones) {
+                    auto &[milliseconds, calls] = totals[zone.name];
+                    milliseconds += static_cast<float>(zone.end - zone.start) / 1.0e6F;
+                    calls++;
+                }
+            }
+        }
+
+        std::vector<std::pair<const char *, Total> > sorted(totals.begin(), totals.end());
+        std::ranges::sort(sorted, [](const auto &a, const auto &b) {
+            return a.second.milliseconds > b.second.milliseconds;
+        });
+
+        if (ImGui::BeginTable("Zones", 3)) {
+            ImGui::TableSetupColumn("Zone");
+            ImGui::TableSetupColumn("ms");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableHeadersRow();
+
+            for (const auto &[name, total]: sorted) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", total.milliseconds);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", total.calls);
+            }
+
+            ImGui::EndTable();
+        }
+#else
+        ImGui::TextUnformatted("Built without CW_PROFILING");
+#endif
+
+        ImGui::End();
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by Jacob Edwards on 20/05/2024.
+//
+/*
+ * https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ */
+
+#ifndef CW_PROFILER_H
+#define CW_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+// scoped cpu zones and frame markers. every thread writes into a ring buffer of its own, so recording
+// never waits on another thread, and the panel and the chrome trace export read them back.
+// only use it through the macros, without CW_PROFILING they expand to nothing and cost nothing
+namespace Profiler {
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Zone {
+        // zone names are string literals, only the pointer is stored
+        const char *name;
+        // nanoseconds since the profiler started
+        std::int64_t start;
+        std::int64_t end;
+        std::uint32_t depth;
+    };
+
+    class Scope {
+    public:
+        explicit Scope(const char *name) noexcept;
+
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+
+        auto operator=(const Scope &) -> Scope & = delete;
+
+    private:
+        const char *name;
+        std::int64_t start;
+    };
+
+    // marks the start of a frame, main thread only
+    void Frame();
+
+    // shown on the thread's lane, must be a string literal
+    void SetThreadName(const char *name);
+
+    // writes every zone still in the buffers as chrome trace json, open it in chrome://tracing or perfetto
+    auto Export(const std::filesystem::path &path) -> bool;
+
+    void Interface();
+}
+
+#ifdef CW_PROFILING
+#define CW_PROFILE_CONCAT_INNER(a, b) a##b
+#define CW_PROFILE_CONCAT(a, b) CW_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) const Profiler::Scope CW_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::Frame()
+#define PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#define PROFILE_ZONE(name) static_cast<void>(0)
+#define PROFILE_FRAME() static_cast<void>(0)
+#define PROFILE_THREAD(name) static_cast<void>(0)
+#endif
+
+#endif //CW_PROFILER_H
@@ -11,12 +11,17 @@
 #include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_float4.hpp>
 #include <glm/ext/vector_float3.hpp>
+#include <cstdint>
 #include <random>
 
 namespace Random {
     std::random_device rnd;
     std::mt19937 gen(rnd());
 
+    void Seed(const std::uint32_t seed) {
+        gen.seed(seed);
+    }
+
     auto Float(const float min, const float max) -> float {
         std::uniform_real_distribution dis(min, max);
         return dis(gen);
@@ -7,10 +7,14 @@
 
 #include <glm/ext/vector_float4.hpp>
 #include <glm/ext/vector_float3.hpp>
+#include <cstdint>
 #include <ranges>
 #include <glm/vec2.hpp>
 
 namespace Random {
+    // reseeds the shared engine, everything drawn after this repeats from run to run
+    void Seed(std::uint32_t seed);
+
     auto Float(float min, float max) -> float;
 
     auto Int(int min, int max) -> int;
@@ -0,0 +1,110 @@
+//
+// Created by Jacob Edwards on 19/05/2024.
+//
+
+#include "StartupTimeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "imgui/imgui.h"
+
+StartupTimeline::Scope::Scope(std::string name) : name(std::move(name)), start(Clock::now()) {
+}
+
+StartupTimeline::Scope::~Scope() {
+    GetInstance().record(std::move(name), start, Clock::now());
+}
+
+StartupTimeline::StartupTimeline(Token) : origin(Clock::now()) {
+}
+
+void StartupTimeline::record(std::string name, const Clock::time_point start, const Clock::time_point end) {
+    const std::scoped_lock lock(mutex);
+
+    const auto thread = std::this_thread::get_id();
+    auto lane = std::ranges::find(lanes, thread);
+    if (lane == lanes.end()) {
+        lane = lanes.insert(lanes.end(), thread);
+    }
+
+    events.push_back({std::move(name), static_cast<std::size_t>(std::distance(lanes.begin(), lane)), since(start),
+                      since(end)});
+}
+
+void StartupTimeline::finish() {
+    const std::scoped_lock lock(mutex);
+    total = since(Clock::now());
+}
+
+auto StartupTimeline::getEvents() const -> std::vector<Event> {
+    const std::scoped_lock lock(mutex);
+    return events;
+}
+
+auto StartupTimeline::getOrigin() const -> Clock::time_point {
+    return origin;
+}
+
+void StartupTimeline::interface() const {
+    const std::scoped_lock lock(mutex);
+
+    ImGui::Begin("Startup");
+    ImGui::Text("Ready after %.1f ms across %zu threads", total, lanes.size());
+
+    constexpr float laneHeight = 18.0F;
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 100.0F);
+    const float scale = total > 0.0F ? width / total : 0.0F;
+
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+
+    for (std::size_t i = 0; i < events.size(); i++) {
+        const auto &[name, lane, start, end] = events[i];
+
+        const ImVec2 min{origin.x + start * scale, origin.y + static_cast<float>(lane) * laneHeight};
+        const ImVec2 max{std::max(origin.x + end * scale, min.x + 1.0F), min.y + laneHeight - 2.0F};
+
+        // alternate shades so neighbouring bars stay distinct
+        const ImU32 color = i % 2 == 0 ? IM_COL32(90, 150, 220, 255) : IM_COL32(60, 110, 180, 255);
+        drawList->AddRectFilled(min, max, color);
+
+        if (ImGui::IsMouseHoveringRect(min, max)) {
+            ImGui::SetTooltip("%s\n%.2f ms", name.c_str(), end - start);
+        }
+    }
+
+    ImGui::Dummy(ImVec2(width, static_cast<float>(lanes.size()) * laneHeight));
+
+    if (ImGui::BeginTable("Events", 3)) {
+        ImGui::TableSetupColumn("Step");
+        ImGui::TableSetupColumn("Thread");
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableHeadersRow();
+
+        for (const auto &[name, lane, start, end]: events) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", lane);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", end - start);
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+auto StartupTimeline::since(const Clock::time_point time) const -> float {
+    return std::chrono::duration<float, std::milli>(time - origin).count();
+}
@@ -0,0 +1,71 @@
+//
+// Created by Jacob Edwards on 19/05/2024.
+//
+
+#ifndef CW_STARTUPTIMELINE_H
+#define CW_STARTUPTIMELINE_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Singleton.h"
+
+// what startup spent its time on, one lane per thread that did any of the work. recorded from the
+// loader threads as well as the gl thread, so everything in here goes through the mutex
+class StartupTimeline final : public Singleton<StartupTimeline> {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Event {
+        std::string name;
+        std::size_t lane;
+        // milliseconds since the timeline was created
+        float start;
+        float end;
+    };
+
+    // records its own lifetime
+    class Scope {
+    public:
+        explicit Scope(std::string name);
+
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+
+        auto operator=(const Scope &) -> Scope & = delete;
+
+    private:
+        std::string name;
+        Clock::time_point start;
+    };
+
+    explicit StartupTimeline(Token);
+
+    void record(std::string name, Clock::time_point start, Clock::time_point end);
+
+    // marks the end of startup, the total stops counting here
+    void finish();
+
+    [[nodiscard]] auto getEvents() const -> std::vector<Event>;
+
+    [[nodiscard]] auto getOrigin() const -> Clock::time_point;
+
+    void interface() const;
+
+private:
+    Clock::time_point origin;
+    float total = 0.0F;
+
+    mutable std::mutex mutex;
+    std::vector<Event> events;
+    std::vector<std::thread::id> lanes;
+
+    [[nodiscard]] auto since(Clock::time_point time) const -> float;
+};
+
+
+#endif //CW_STARTUPTIMELINE_H
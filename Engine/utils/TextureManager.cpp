@@ -0,0 +1,284 @@
+//
+// Created by Jacob Edwards on 18/05/2024.
+//
+
+#include "TextureManager.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "Allocations.h"
+#include "graphics/GpuMemory.h"
+#include "graphics/Texture.h"
+#include "imgui/imgui.h"
+#include "Profiler.h"
+
+TextureManager::Resident::~Resident() {
+    GpuMemory::Release(GpuMemory::Object::TEXTURE, id);
+    glDeleteTextures(1, &id);
+}
+
+TextureManager::TextureManager(Token) {
+    glGenBuffers(1, &pixelBuffer);
+
+    // decoding is the slow part, leave a core for the gl thread
+    const unsigned int threads = std::clamp(std::thread::hardware_concurrency(), 2U, 5U) - 1U;
+
+    workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; i++) {
+        workers.emplace_back([this](const std::stop_token &stop) {
+            work(stop);
+        });
+    }
+}
+
+TextureManager::~TextureManager() {
+    // the workers have to be gone before the queues they read
+    workers.clear();
+
+    glDeleteBuffers(1, &pixelBuffer);
+}
+
+auto TextureManager::load(const std::filesystem::path &path) -> Handle {
+    return load(path, Sampler{});
+}
+
+auto TextureManager::load(const std::filesystem::path &path, const Sampler sampler) -> Handle {
+    Key key{Canonical(path), sampler};
+
+    if (const auto it = textures.find(key); it != textures.end()) {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+
+    auto texture = std::make_shared<Resident>();
+    glGenTextures(1, &texture->id);
+    texture->path = key.first;
+    texture->sampler = sampler;
+    Placeholder(*texture);
+
+    {
+        const std::scoped_lock lock(mutex);
+        jobs.push_back({texture, path});
+    }
+    available.notify_one();
+
+    textures.emplace(std::move(key), texture);
+    return texture;
+}
+
+void TextureManager::update() {
+    PROFILE_ZONE("Texture upload");
+    ALLOCATION_SCOPE(ASSETS);
+
+    std::size_t uploaded = 0;
+
+    while (uploaded == 0 || uploaded < uploadBudget) {
+        Decoded next;
+
+        {
+            const std::scoped_lock lock(mutex);
+            if (decoded.empty()) {
+                break;
+            }
+
+            next = std::move(decoded.front());
+            decoded.pop_front();
+        }
+
+        // evicted while it was decoding
+        const auto texture = next.texture.lock();
+        if (texture == nullptr || next.image.pixels == nullptr) {
+            continue;
+        }
+
+        upload(*texture, next.image);
+        uploaded += texture->bytes;
+    }
+
+    uploadedLastFrame = uploaded;
+}
+
+auto TextureManager::collect() -> std::size_t {
+    return std::erase_if(textures, [](const auto &entry) {
+        return entry.second.use_count() == 1;
+    });
+}
+
+auto TextureManager::getResidentBytes() const -> std::size_t {
+    return std::accumulate(textures.begin(), textures.end(), std::size_t{0}, [](const auto total, const auto &entry) {
+        return total + entry.second->bytes;
+    });
+}
+
+auto TextureManager::getPending() const -> std::size_t {
+    const std::scoped_lock lock(mutex);
+    return jobs.size() + decoding + decoded.size();
+}
+
+void TextureManager::interface() {
+    ImGui::Begin("Texture Manager");
+    ImGui::Text("Resident: %zu textures, %.1f MB", textures.size(),
+                static_cast<float>(getResidentBytes()) / (1024.0F * 1024.0F));
+    ImGui::Text("Hits: %zu, Loads: %zu", hits, misses);
+    ImGui::Text("Pending: %zu, Uploaded Last Frame: %.1f KB", getPending(),
+                static_cast<float>(uploadedLastFrame) / 1024.0F);
+
+    int budget = static_cast<int>(uploadBudget / (1024U * 1024U));
+    if (ImGui::SliderInt("Upload Budget (MB)", &budget, 1, 64)) {
+        uploadBudget = static_cast<std::size_t>(budget) * 1024U * 1024U;
+    }
+
+    if (ImGui::Button("Evict unused")) {
+        collect();
+    }
+
+    if (ImGui::BeginTable("Textures", 4)) {
+        ImGui::TableSetupColumn("Path");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("KB");
+        ImGui::TableSetupColumn("Handles");
+        ImGui::TableHeadersRow();
+
+        for (const auto &[key, texture]: textures) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(texture->path.filename().string().c_str());
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("%s", texture->path.string().c_str());
+            }
+            ImGui::TableNextColumn();
+            if (texture->ready) {
+                ImGui::Text("%dx%d", texture->width, texture->height);
+            } else {
+                ImGui::TextUnformatted("loading");
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", static_cast<float>(texture->bytes) / 1024.0F);
+            ImGui::TableNextColumn();
+            // the manager's own reference isn't a consumer
+            ImGui::Text("%ld", texture.use_count() - 1);
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+void TextureManager::work(const std::stop_token &stop) {
+    PROFILE_THREAD("Texture decoder");
+    ALLOCATION_SCOPE(ASSETS);
+
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock lock(mutex);
+            if (!available.wait(lock, stop, [this] { return !jobs.empty(); })) {
+                return;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            decoding++;
+        }
+
+        Texture::Loader::Image image;
+
+        {
+            PROFILE_ZONE("Texture decode");
+            image = Texture::Loader::decode(job.path);
+        }
+
+        {
+            const std::scoped_lock lock(mutex);
+            decoded.push_back({std::move(job.texture), std::move(image)});
+            decoding--;
+        }
+    }
+}
+
+void TextureManager::upload(Resident &texture, const Texture::Loader::Image &image) const {
+    const auto size = image.size;
+
+    // orphaned each time, so the copy never waits on the previous upload
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+
+    // offsets are into the pixel buffer, unless it couldn't be filled
+    const unsigned char *pixels = nullptr;
+
+    void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped != nullptr) {
+        std::memcpy(mapped, image.pixels.get(), size);
+    }
+
+    // a failed map, or an unmap that reports the store was lost, falls back to a plain upload from the decoded
+    // copy. slower, as the driver copies it on the spot, but the texture still arrives this frame
+    if (mapped == nullptr || glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        pixels = image.pixels.get();
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+
+    if (!Texture::Loader::upload(image, pixels)) {
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texture.sampler.wrapS);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texture.sampler.wrapT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture.sampler.minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, texture.sampler.magFilter);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.bytes = Texture::Loader::residentBytes(image);
+    texture.ready = true;
+
+    GpuMemory::Track(GpuMemory::Object::TEXTURE, texture.id, GpuMemory::Category::TEXTURES, texture.bytes,
+                     "Texture manager");
+}
+
+auto TextureManager::Canonical(const std::filesystem::path &path) -> std::filesystem::path {
+    std::error_code error;
+    auto canonical = std::filesystem::weakly_canonical(path, error);
+    return error ? path.lexically_normal() : canonical;
+}
+
+void TextureManager::Placeholder(const Resident &texture) {
+    constexpr std::array<unsigned char, 4> grey = {128, 128, 128, 255};
+
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey.data());
+    GpuMemory::Track(GpuMemory::Object::TEXTURE, texture.id, GpuMemory::Category::TEXTURES, grey.size(),
+                     "Texture manager");
+
+    // no mips yet, a mipmapped filter would leave the texture incomplete
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
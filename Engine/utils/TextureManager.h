@@ -0,0 +1,127 @@
+//
+// Created by Jacob Edwards on 18/05/2024.
+//
+/*
+ * https://www.khronos.org/opengl/wiki/Pixel_Buffer_Object
+ */
+
+#ifndef CW_TEXTUREMANAGER_H
+#define CW_TEXTUREMANAGER_H
+
+#include <GL/glew.h>
+#include <compare>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "graphics/Texture.h"
+#include "Singleton.h"
+
+// every file texture in the app, keyed by canonical path and sampler state so two models using the same
+// image share one gl texture. like the asset manager, a handle's use count is its reference count and
+// collect evicts whatever nothing else holds.
+// loads return straight away with a grey placeholder, the file is decoded on a worker thread and update
+// streams finished images through a pixel buffer into the same texture name, a few per frame
+class TextureManager final : public Singleton<TextureManager> {
+public:
+    struct Sampler {
+        GLint wrapS = GL_REPEAT;
+        GLint wrapT = GL_REPEAT;
+        GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+        GLint magFilter = GL_LINEAR;
+
+        auto operator<=>(const Sampler &) const = default;
+    };
+
+    // owns the gl texture, deleted with the last handle
+    struct Resident {
+        GLuint id = 0U;
+        std::filesystem::path path;
+        Sampler sampler;
+        GLsizei width = 0;
+        GLsizei height = 0;
+        std::size_t bytes = 0;
+        bool ready = false;
+
+        Resident() = default;
+
+        ~Resident();
+
+        Resident(const Resident &) = delete;
+
+        auto operator=(const Resident &) -> Resident & = delete;
+    };
+
+    using Handle = std::shared_ptr<const Resident>;
+
+    explicit TextureManager(Token);
+
+    ~TextureManager() override;
+
+    // not a defaulted argument, the sampler's member initialisers aren't usable until the class is complete
+    auto load(const std::filesystem::path &path) -> Handle;
+
+    auto load(const std::filesystem::path &path, Sampler sampler) -> Handle;
+
+    // uploads decoded images until the frame's byte budget is spent, gl thread only
+    void update();
+
+    // drops every texture no model holds, returns how many went
+    auto collect() -> std::size_t;
+
+    [[nodiscard]] auto getResidentBytes() const -> std::size_t;
+
+    [[nodiscard]] auto getPending() const -> std::size_t;
+
+    void interface();
+
+private:
+    using Key = std::pair<std::filesystem::path, Sampler>;
+
+    struct Job {
+        std::weak_ptr<Resident> texture;
+        std::filesystem::path path;
+    };
+
+    struct Decoded {
+        std::weak_ptr<Resident> texture;
+        Texture::Loader::Image image;
+    };
+
+    std::map<Key, std::shared_ptr<Resident> > textures;
+
+    // at least one image goes up every frame, however big
+    std::size_t uploadBudget = 8U * 1024U * 1024U;
+
+    GLuint pixelBuffer = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable_any available;
+    std::deque<Job> jobs;
+    std::deque<Decoded> decoded;
+    std::size_t decoding = 0;
+
+    std::vector<std::jthread> workers;
+
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t uploadedLastFrame = 0;
+
+    void work(const std::stop_token &stop);
+
+    void upload(Resident &texture, const Texture::Loader::Image &image) const;
+
+    static auto Canonical(const std::filesystem::path &path) -> std::filesystem::path;
+
+    static void Placeholder(const Resident &texture);
+};
+
+
+#endif //CW_TEXTUREMANAGER_H
@@ -0,0 +1,537 @@
+//
+// Created by Jacob Edwards on 19/05/2024.
+//
+/*
+ * https://learn.microsoft.com/en-us/windows/win32/direct3d10/d3d10-graphics-programming-guide-resources-block-compression
+ * https://www.khronos.org/opengl/wiki/S3_Texture_Compression
+ */
+
+// bakes every texture under Assets/objects into the container the loader prefers, with the full mip
+// chain built offline and optionally bc1/bc3 block compressed. only files whose source is newer than
+// their bake, or whose bake has another version or encoding, are redone unless --force is given.
+//
+//     AssetBaker [--compress] [--force] [root]
+//
+// run from the build directory like the app, root defaults to ../Assets/objects
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include "graphics/stb_image.h"
+
+#include "graphics/TextureContainer.h"
+
+namespace {
+    using namespace Texture::Container;
+
+    constexpr std::array<std::string_view, 5> EXTENSIONS = {".png", ".jpg", ".jpeg", ".tga", ".bmp"};
+
+    struct Options {
+        bool compress = false;
+        bool force = false;
+        std::filesystem::path root = "../Assets/objects";
+    };
+
+    struct Result {
+        std::filesystem::path source;
+        bool baked = false;
+        bool failed = false;
+        // what the runtime path uploads, level 0 plus a generated chain
+        std::size_t before = 0;
+        std::size_t after = 0;
+    };
+
+    struct Pixels {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::vector<unsigned char> data;
+    };
+
+    auto Bytes(const Pixels &pixels) -> std::size_t {
+        return static_cast<std::size_t>(pixels.width) * static_cast<std::size_t>(pixels.height) *
+               static_cast<std::size_t>(pixels.channels);
+    }
+
+    // 2x2 box filter, an odd edge repeats its last texel
+    auto Downsample(const Pixels &source) -> Pixels {
+        Pixels level;
+        level.width = std::max(source.width / 2, 1);
+        level.height = std::max(source.height / 2, 1);
+        level.channels = source.channels;
+        level.data.resize(Bytes(level));
+
+        const auto texel = [&source](const int x, const int y, const int c) {
+            const int cx = std::min(x, source.width - 1);
+            const int cy = std::min(y, source.height - 1);
+            return static_cast<unsigned int>(source.data[(static_cast<std::size_t>(cy) * source.width + cx) *
+                                                         source.channels + c]);
+        };
+
+        for (int y = 0; y < level.height; y++) {
+            for (int x = 0; x < level.width; x++) {
+                for (int c = 0; c < level.channels; c++) {
+                    const unsigned int sum = texel(2 * x, 2 * y, c) + texel(2 * x + 1, 2 * y, c) +
+                                             texel(2 * x, 2 * y + 1, c) + texel(2 * x + 1, 2 * y + 1, c);
+                    level.data[(static_cast<std::size_t>(y) * level.width + x) * level.channels + c] =
+                            static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+
+        return level;
+    }
+
+    auto To565(const std::array<int, 3> &color) -> std::uint16_t {
+        return static_cast<std::uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+    }
+
+    auto From565(const std::uint16_t color) -> std::array<int, 3> {
+        const int r = (color >> 11) & 31;
+        const int g = (color >> 5) & 63;
+        const int b = color & 31;
+        return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+    }
+
+    template<typename T>
+    void Append(std::vector<unsigned char> &out, const T value) {
+        const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // endpoints are the extremes along the block's principal axis, then each texel takes the nearest of
+    // the four palette entries
+    void EncodeColorBlock(const std::array<std::array<int, 4>, 16> &block, std::vector<unsigned char> &out) {
+        std::array<float, 3> mean{};
+        for (const auto &texel: block) {
+            for (int c = 0; c < 3; c++) {
+                mean[c] += static_cast<float>(texel[c]) / 16.0F;
+            }
+        }
+
+        std::array<std::array<float, 3>, 3> covariance{};
+        for (const auto &texel: block) {
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    covariance[i][j] += (static_cast<float>(texel[i]) - mean[i]) *
+                            (static_cast<float>(texel[j]) - mean[j]);
+                }
+            }
+        }
+
+        // a few rounds of power iteration are plenty for a 3x3
+        std::array<float, 3> axis = {1.0F, 1.0F, 1.0F};
+        for (int iteration = 0; iteration < 8; iteration++) {
+            std::array<float, 3> next{};
+            for (int i = 0; i < 3; i++) {
+                next[i] = covariance[i][0] * axis[0] + covariance[i][1] * axis[1] + covariance[i][2] * axis[2];
+            }
+
+            const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+            if (length < 1e-6F) {
+                break;
+            }
+
+            axis = {next[0] / length, next[1] / length, next[2] / length};
+        }
+
+        float lowest = std::numeric_limits<float>::max();
+        float highest = std::numeric_limits<float>::lowest();
+        for (const auto &texel: block) {
+            float projection = 0.0F;
+            for (int c = 0; c < 3; c++) {
+                projection += (static_cast<float>(texel[c]) - mean[c]) * axis[c];
+            }
+            lowest = std::min(lowest, projection);
+            highest = std::max(highest, projection);
+        }
+
+        std::array<int, 3> low{};
+        std::array<int, 3> high{};
+        for (int c = 0; c < 3; c++) {
+            low[c] = std::clamp(static_cast<int>(std::lround(mean[c] + axis[c] * lowest)), 0, 255);
+            high[c] = std::clamp(static_cast<int>(std::lround(mean[c] + axis[c] * highest)), 0, 255);
+        }
+
+        std::uint16_t color0 = To565(high);
+        std::uint16_t color1 = To565(low);
+
+        // color0 > color1 selects the four colour mode
+        if (color0 < color1) {
+            std::swap(color0, color1);
+        }
+
+        std::uint32_t indices = 0;
+
+        if (color0 != color1) {
+            const auto end0 = From565(color0);
+            const auto end1 = From565(color1);
+
+            std::array<std::array<int, 3>, 4> palette{};
+            for (int c = 0; c < 3; c++) {
+                palette[0][c] = end0[c];
+                palette[1][c] = end1[c];
+                palette[2][c] = (2 * end0[c] + end1[c]) / 3;
+                palette[3][c] = (end0[c] + 2 * end1[c]) / 3;
+            }
+
+            for (std::size_t i = 0; i < block.size(); i++) {
+                std::uint32_t best = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+
+                for (std::uint32_t p = 0; p < palette.size(); p++) {
+                    int distance = 0;
+                    for (int c = 0; c < 3; c++) {
+                        const int d = block[i][c] - palette[p][c];
+                        distance += d * d;
+                    }
+
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+
+                indices |= best << (2 * i);
+            }
+        }
+
+        Append(out, color0);
+        Append(out, color1);
+        Append(out, indices);
+    }
+
+    void EncodeAlphaBlock(const std::array<std::array<int, 4>, 16> &block, std::vector<unsigned char> &out) {
+        int alpha0 = 0;
+        int alpha1 = 255;
+
+        for (const auto &texel: block) {
+            alpha0 = std::max(alpha0, texel[3]);
+            alpha1 = std::min(alpha1, texel[3]);
+        }
+
+        std::uint64_t indices = 0;
+
+        // alpha0 > alpha1 selects the eight value mode
+        if (alpha0 != alpha1) {
+            std::array<int, 8> palette{alpha0, alpha1};
+            for (int i = 1; i < 7; i++) {
+                palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+            }
+
+            for (std::size_t i = 0; i < block.size(); i++) {
+                std::uint64_t best = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+
+                for (std::uint64_t p = 0; p < palette.size(); p++) {
+                    const int distance = std::abs(block[i][3] - palette[p]);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+
+                indices |= best << (3 * i);
+            }
+        }
+
+        out.push_back(static_cast<unsigned char>(alpha0));
+        out.push_back(static_cast<unsigned char>(alpha1));
+        for (int i = 0; i < 6; i++) {
+            out.push_back(static_cast<unsigned char>((indices >> (8 * i)) & 0xFF));
+        }
+    }
+
+    auto Compress(const Pixels &level, const Encoding encoding) -> std::vector<unsigned char> {
+        std::vector<unsigned char> out;
+
+        for (int by = 0; by < level.height; by += 4) {
+            for (int bx = 0; bx < level.width; bx += 4) {
+                std::array<std::array<int, 4>, 16> block{};
+
+                for (int y = 0; y < 4; y++) {
+                    for (int x = 0; x < 4; x++) {
+                        // blocks hanging off the edge repeat the last row and column
+                        const int cx = std::min(bx + x, level.width - 1);
+                        const int cy = std::min(by + y, level.height - 1);
+                        const auto *texel = &level.data[(static_cast<std::size_t>(cy) * level.width + cx) *
+                                                        level.channels];
+
+                        auto &target = block[y * 4 + x];
+                        target = {texel[0], texel[1], texel[2], level.channels == 4 ? texel[3] : 255};
+                    }
+                }
+
+                if (encoding == Encoding::BC3) {
+                    EncodeAlphaBlock(block, out);
+                }
+                EncodeColorBlock(block, out);
+            }
+        }
+
+        return out;
+    }
+
+    auto RawEncoding(const int channels) -> Encoding {
+        switch (channels) {
+            case 1:
+                return Encoding::R8;
+            case 2:
+                return Encoding::RG8;
+            case 3:
+                return Encoding::RGB8;
+            default:
+                return Encoding::RGBA8;
+        }
+    }
+
+    // only colour images are worth compressing, one and two channel data stays exact
+    auto Choose(const int channels, const Options &options) -> Encoding {
+        if (options.compress && channels >= 3) {
+            return channels == 4 ? Encoding::BC3 : Encoding::BC1;
+        }
+
+        return RawEncoding(channels);
+    }
+
+    // the bytes the loader will upload for an existing bake, nothing when it was baked by another version
+    // or with a different encoding, so flipping --compress redoes everything
+    auto BakedBytes(const std::filesystem::path &baked, const Encoding encoding) -> std::optional<std::size_t> {
+        std::ifstream file(baked, std::ios::binary);
+        Header header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(Header));
+
+        if (!file || header.magic != MAGIC || header.version != VERSION || header.encoding != encoding ||
+            header.flipped != 1 || header.levels == 0) {
+            return std::nullopt;
+        }
+
+        std::error_code error;
+        const auto size = std::filesystem::file_size(baked, error);
+        if (error || header.levels > (size - sizeof(Header)) / sizeof(Level)) {
+            return std::nullopt;
+        }
+
+        std::vector<Level> levels(header.levels);
+        file.read(reinterpret_cast<char *>(levels.data()), static_cast<std::streamsize>(levels.size() * sizeof(Level)));
+
+        if (!file) {
+            return std::nullopt;
+        }
+
+        const auto end = extent(header, levels, size - sizeof(Header) - levels.size() * sizeof(Level));
+        return end.has_value() ? std::optional(static_cast<std::size_t>(*end)) : std::nullopt;
+    }
+
+    auto Bake(const std::filesystem::path &source, const Options &options) -> Result {
+        Result result{source};
+
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        if (stbi_info(source.c_str(), &width, &height, &channels) == 0) {
+            result.failed = true;
+            return result;
+        }
+
+        const auto base = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) *
+                          static_cast<std::size_t>(channels);
+        result.before = base + base / 3;
+
+        const auto baked = bakedPath(source);
+        const Encoding encoding = Choose(channels, options);
+
+        if (!options.force && isCurrent(source)) {
+            if (const auto bytes = BakedBytes(baked, encoding)) {
+                result.after = *bytes;
+                return result;
+            }
+        }
+
+        unsigned char *data = stbi_load(source.c_str(), &width, &height, &channels, 0);
+        if (data == nullptr) {
+            std::println(stderr, "Failed to load texture: {} - {}", source.string(), stbi_failure_reason());
+            result.failed = true;
+            return result;
+        }
+
+        Pixels level{width, height, channels, {}};
+        level.data.assign(data, data + Bytes(level));
+        stbi_image_free(data);
+
+        Header header;
+        header.encoding = encoding;
+        header.width = static_cast<std::uint32_t>(width);
+        header.height = static_cast<std::uint32_t>(height);
+        header.flipped = 1;
+
+        std::vector<Level> levels;
+        std::vector<unsigned char> blob;
+
+        while (true) {
+            auto encoded = isCompressed(encoding) ? Compress(level, encoding) : level.data;
+
+            levels.push_back({
+                static_cast<std::uint32_t>(level.width), static_cast<std::uint32_t>(level.height), blob.size(),
+                encoded.size()
+            });
+            blob.insert(blob.end(), encoded.begin(), encoded.end());
+
+            if (level.width == 1 && level.height == 1) {
+                break;
+            }
+
+            level = Downsample(level);
+        }
+
+        header.levels = static_cast<std::uint32_t>(levels.size());
+
+        // written beside the real file and renamed over it, an interrupted bake never looks current
+        auto temporary = baked;
+        temporary += ".tmp";
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+            file.write(reinterpret_cast<const char *>(levels.data()),
+                       static_cast<std::streamsize>(levels.size() * sizeof(Level)));
+            file.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+            if (!file) {
+                std::println(stderr, "Could not write {}", temporary.string());
+                result.failed = true;
+                return result;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, baked, error);
+        if (error) {
+            std::println(stderr, "Could not write {}: {}", baked.string(), error.message());
+            result.failed = true;
+            return result;
+        }
+
+        result.baked = true;
+        result.after = blob.size();
+        return result;
+    }
+
+    auto Find(const std::filesystem::path &root) -> std::vector<std::filesystem::path> {
+        std::vector<std::filesystem::path> sources;
+
+        for (const auto &entry: std::filesystem::recursive_directory_iterator(root)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+
+            auto extension = entry.path().extension().string();
+            std::ranges::transform(extension, extension.begin(), [](const unsigned char c) {
+                return static_cast<char>(std::tolower(c));
+            });
+
+            if (std::ranges::find(EXTENSIONS, extension) != EXTENSIONS.end()) {
+                sources.push_back(entry.path());
+            }
+        }
+
+        std::ranges::sort(sources);
+        return sources;
+    }
+
+    auto Megabytes(const std::size_t bytes) -> double {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+}
+
+auto main(const int argc, char *argv[]) -> int {
+    Options options;
+
+    for (const std::span arguments(argv + 1, static_cast<std::size_t>(argc - 1)); const std::string_view argument:
+         arguments) {
+        if (argument == "--compress") {
+            options.compress = true;
+        } else if (argument == "--force") {
+            options.force = true;
+        } else {
+            options.root = argument;
+        }
+    }
+
+    if (!std::filesystem::is_directory(options.root)) {
+        std::println(stderr, "No such directory: {}", options.root.string());
+        return 1;
+    }
+
+    // the app flips on load, so the bakes are stored flipped too
+    stbi_set_flip_vertically_on_load(1);
+
+    const auto sources = Find(options.root);
+    std::vector<Result> results(sources.size());
+    std::atomic<std::size_t> next = 0;
+
+    {
+        const unsigned int threads = std::max(std::thread::hardware_concurrency(), 1U);
+        std::vector<std::jthread> workers;
+        workers.reserve(threads);
+
+        for (unsigned int i = 0; i < threads; i++) {
+            workers.emplace_back([&] {
+                for (std::size_t index = next++; index < sources.size(); index = next++) {
+                    results[index] = Bake(sources[index], options);
+                }
+            });
+        }
+    }
+
+    std::size_t before = 0;
+    std::size_t after = 0;
+    std::size_t baked = 0;
+    std::size_t failed = 0;
+
+    for (const auto &result: results) {
+        const auto name = std::filesystem::relative(result.source, options.root).string();
+
+        if (result.failed) {
+            std::println("  failed   {}", name);
+            failed++;
+            continue;
+        }
+
+        std::println("  {:<8} {:<60} {:>8.2f} MB -> {:>8.2f} MB", result.baked ? "baked" : "current", name,
+                     Megabytes(result.before), Megabytes(result.after));
+
+        before += result.before;
+        after += result.after;
+        baked += result.baked ? 1 : 0;
+    }
+
+    std::println("{} textures, {} baked, {} current, {} failed", results.size(), baked,
+                 results.size() - baked - failed, failed);
+    std::println("VRAM {:.2f} MB -> {:.2f} MB", Megabytes(before), Megabytes(after));
+
+    return failed == 0 ? 0 : 1;
+}
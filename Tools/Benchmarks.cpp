@@ -0,0 +1,383 @@
+//
+// Created by Jacob Edwards on 22/05/2024.
+//
+
+// micro benchmarks for the engine's hot paths, run headless so they work on machines without a gpu.
+// each case is timed in batches, the batch size grows until one batch takes a few milliseconds and the
+// per call time is reported over several batches. --json writes the same numbers for comparing commits.
+//
+//     Benchmarks [--filter text] [--json path] [--batches n]
+//
+// run from the build directory like the app, the particle and terrain cases load models from ../Assets
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float3.hpp>
+
+#include "App.h"
+#include "graphics/Color.h"
+#include "physics/Collisions.h"
+#include "physics/ModelAttributes.h"
+#include "physics/Spline.h"
+#include "renderables/Entity.h"
+#include "renderables/Particle.h"
+#include "renderables/objects/Player.h"
+#include "renderables/objects/ProceduralTerrain.h"
+#include "utils/BoundingBox.h"
+#include "utils/Noise.h"
+#include "utils/PlayerManager.h"
+#include "utils/Random.h"
+
+namespace {
+    using Clock = std::chrono::high_resolution_clock;
+
+    // runs the operation being measured the given number of times
+    using Body = std::function<void(std::size_t)>;
+
+    struct Case {
+        std::string_view name;
+        // untimed, builds whatever the body works on
+        std::function<Body()> setup;
+    };
+
+    struct Result {
+        std::string_view name;
+        std::size_t iterations = 0;
+        // nanoseconds per call
+        double min = 0.0;
+        double median = 0.0;
+        double mean = 0.0;
+        double max = 0.0;
+    };
+
+    struct Options {
+        std::string filter;
+        std::filesystem::path json;
+        std::size_t batches = 10;
+    };
+
+    // a batch shorter than this is mostly timer overhead
+    constexpr auto MIN_BATCH = std::chrono::milliseconds(5);
+
+    // stops the compiler dropping work whose result is never used
+    volatile float sink = 0.0F;
+
+    void Consume(const float value) {
+        sink = sink + value;
+    }
+
+    void Consume(const glm::vec3 &value) {
+        Consume(value.x + value.y + value.z);
+    }
+
+    auto Time(const Body &body, const std::size_t iterations) -> double {
+        const auto start = Clock::now();
+        body(iterations);
+        const auto end = Clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    auto Run(const Case &benchmark, const std::size_t batches) -> Result {
+        const Body body = benchmark.setup();
+
+        std::size_t iterations = 1;
+        while (Time(body, iterations) < std::chrono::duration<double, std::nano>(MIN_BATCH).count()) {
+            iterations *= 2;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(batches);
+
+        for (std::size_t i = 0; i < batches; i++) {
+            samples.push_back(Time(body, iterations) / static_cast<double>(iterations));
+        }
+
+        std::ranges::sort(samples);
+
+        double total = 0.0;
+        for (const double sample: samples) {
+            total += sample;
+        }
+
+        return {
+            benchmark.name, iterations, samples.front(), samples[samples.size() / 2],
+            total / static_cast<double>(samples.size()), samples.back()
+        };
+    }
+
+    auto RandomBoxes(const std::size_t count) -> std::vector<BoundingBox> {
+        std::vector<BoundingBox> boxes;
+        boxes.reserve(count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            const glm::vec3 min = Random::Vec3(-100.0F, 100.0F);
+            boxes.emplace_back(min, min + Random::Vec3(1.0F, 20.0F));
+        }
+
+        return boxes;
+    }
+
+    // the same shapes and counts the scene uses, so the numbers say something about a frame
+    auto Cases() -> std::vector<Case> {
+        return {
+            {
+                "Noise::Simplex terrain height", []() -> Body {
+                    return [](const std::size_t iterations) {
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            const auto position = glm::vec2(static_cast<float>(i % 1024U),
+                                                            static_cast<float>(i / 1024U % 1024U));
+                            Consume(Noise::Simplex(position, 0.1F, 8, 0.05F, 2.0F));
+                        }
+                    };
+                }
+            },
+            {
+                "BoundingBox::collides", []() -> Body {
+                    auto boxes = std::make_shared<std::vector<BoundingBox> >(RandomBoxes(1024));
+
+                    return [boxes](const std::size_t iterations) {
+                        std::size_t hits = 0;
+
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            const auto &a = (*boxes)[i % boxes->size()];
+                            const auto &b = (*boxes)[(i * 7U + 1U) % boxes->size()];
+                            hits += a.collides(b) ? 1U : 0U;
+                        }
+
+                        Consume(static_cast<float>(hits));
+                    };
+                }
+            },
+            {
+                "Collisions::check boxes", []() -> Body {
+                    auto boxes = std::make_shared<std::vector<BoundingBox> >(RandomBoxes(1024));
+
+                    return [boxes](const std::size_t iterations) {
+                        std::size_t hits = 0;
+
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            const auto &a = (*boxes)[i % boxes->size()];
+                            const auto &b = (*boxes)[(i * 7U + 1U) % boxes->size()];
+                            hits += Physics::Collisions::check(a, b) ? 1U : 0U;
+                        }
+
+                        Consume(static_cast<float>(hits));
+                    };
+                }
+            },
+            {
+                "Collisions::resolve impulse", []() -> Body {
+                    auto pair = std::make_shared<std::array<Physics::Attributes, 2> >();
+                    (*pair)[0].position = glm::vec3(-1.0F, 0.0F, 0.0F);
+                    (*pair)[1].position = glm::vec3(1.0F, 0.0F, 0.0F);
+                    (*pair)[0].mass = 10.0F;
+                    (*pair)[1].mass = 10.0F;
+
+                    return [pair](const std::size_t iterations) {
+                        auto &[a, b] = *pair;
+
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            // approaching again every call, otherwise it returns before doing anything
+                            a.velocity = glm::vec3(5.0F, 0.0F, 0.0F);
+                            b.velocity = glm::vec3(-5.0F, 0.0F, 0.0F);
+                            Physics::Collisions::resolve(a, b, glm::vec3(0.0F));
+                        }
+
+                        Consume(a.velocity);
+                    };
+                }
+            },
+            {
+                "Spline::update and getPoint", []() -> Body {
+                    std::vector<glm::vec3> points;
+                    for (int i = 0; i < 20; i++) {
+                        points.push_back(Random::Vec3(-100.0F, 100.0F));
+                    }
+
+                    auto spline = std::make_shared<Physics::Spline>(points, Physics::Spline::Type::CATMULLROM, 1.0F);
+
+                    return [spline](const std::size_t iterations) {
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            spline->update(1.0F / 60.0F);
+                            Consume(spline->getPoint());
+                        }
+                    };
+                }
+            },
+            {
+                "Attributes::update", []() -> Body {
+                    auto attributes = std::make_shared<std::vector<Physics::Attributes> >(1024);
+
+                    for (auto &entry: *attributes) {
+                        entry.velocity = Random::Vec3(-5.0F, 5.0F);
+                        entry.angularVelocity = Random::Vec3(-1.0F, 1.0F);
+                    }
+
+                    return [attributes](const std::size_t iterations) {
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            auto &entry = (*attributes)[i % attributes->size()];
+                            entry.update(1.0F / 60.0F);
+                            Consume(entry.position);
+                        }
+                    };
+                }
+            },
+            {
+                "Entity::update 1024", []() -> Body {
+                    auto entities = std::make_shared<std::vector<std::shared_ptr<Entity> > >();
+
+                    for (int i = 0; i < 1024; i++) {
+                        const auto entity = entities->emplace_back(std::make_shared<Entity>());
+                        entity->attributes.velocity = Random::Vec3(-5.0F, 5.0F);
+                        entity->attributes.angularVelocity = Random::Vec3(-1.0F, 1.0F);
+                    }
+
+                    return [entities](const std::size_t iterations) {
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            const auto &entity = (*entities)[i % entities->size()];
+                            entity->update(1.0F / 60.0F);
+                            Consume(entity->attributes.position);
+                        }
+                    };
+                }
+            },
+            {
+                "ParticleSystem::update 10000", []() -> Body {
+                    ParticleSystem &particleSystem = ParticleSystem::GetInstance();
+
+                    while (particleSystem.getParticles().size() < 10000) {
+                        particleSystem.generate(Random::Vec3(-100.0F, 100.0F), Random::Vec3(-5.0F, 5.0F), Color::WHITE,
+                                                100, 1.0F);
+                    }
+
+                    return [&particleSystem](const std::size_t iterations) {
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            // small enough that nothing dies between batches
+                            particleSystem.update(1.0e-7F);
+                        }
+                    };
+                }
+            },
+            {
+                "ProceduralTerrain 4x4 chunks", []() -> Body {
+                    // loads the tree and cloud models once, so the timed builds only generate
+                    const ProceduralTerrain warm(DEFAULT_CENTRE, DEFAULT_CHUNK_SIZE, 1, 1);
+
+                    return [](const std::size_t iterations) {
+                        for (std::size_t i = 0; i < iterations; i++) {
+                            const ProceduralTerrain terrain(DEFAULT_CENTRE, DEFAULT_CHUNK_SIZE, 4, 4);
+                            Consume(terrain.getTerrainHeight(0.0F, 0.0F));
+                        }
+                    };
+                }
+            },
+        };
+    }
+
+    auto ParseOptions(const std::span<char *const> arguments) -> Options {
+        Options options;
+
+        for (std::size_t i = 1; i < arguments.size(); i++) {
+            const std::string_view argument = arguments[i];
+            const bool hasValue = i + 1 < arguments.size();
+
+            if (argument == "--filter" && hasValue) {
+                options.filter = arguments[++i];
+            } else if (argument == "--json" && hasValue) {
+                options.json = arguments[++i];
+            } else if (argument == "--batches" && hasValue) {
+                const std::string_view value = arguments[++i];
+                std::size_t batches = 0;
+
+                if (const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), batches);
+                    error == std::errc() && batches > 0) {
+                    options.batches = batches;
+                } else {
+                    std::println(stderr, "Invalid batch count '{}'", value);
+                }
+            } else {
+                std::println(stderr, "Unknown argument '{}'", argument);
+            }
+        }
+
+        return options;
+    }
+
+    auto WriteJson(const std::filesystem::path &path, const std::span<const Result> results) -> bool {
+        std::ofstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        std::println(file, "{{");
+        std::println(file, "  \"benchmarks\": [");
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const auto &[name, iterations, min, median, mean, max] = results[i];
+
+            std::println(file,
+                         "    {{\"name\": \"{}\", \"iterations\": {}, \"min_ns\": {:.3f}, \"median_ns\": {:.3f}, "
+                         "\"mean_ns\": {:.3f}, \"max_ns\": {:.3f}}}{}",
+                         name, iterations, min, median, mean, max, i + 1 < results.size() ? "," : "");
+        }
+
+        std::println(file, "  ]");
+        std::println(file, "}}");
+
+        return file.good();
+    }
+}
+
+auto main(const int argc, char **argv) -> int {
+    const Options options = ParseOptions(std::span(argv, static_cast<std::size_t>(argc)));
+
+    // nothing here draws, and the cases have to give the same numbers every run
+    App::headless = true;
+    Random::Seed(1);
+
+    // the particles face the current player's camera
+    PlayerManager::GetInstance().add("Free", std::make_shared<Player>(Player::Mode::FREE));
+
+    std::vector<Result> results;
+
+    std::println("{:<36}{:>14}{:>14}{:>14}{:>14}", "Benchmark", "Iterations", "Min (ns)", "Median (ns)", "Max (ns)");
+
+    for (const auto &benchmark: Cases()) {
+        if (!options.filter.empty() && !benchmark.name.contains(options.filter)) {
+            continue;
+        }
+
+        const auto &result = results.emplace_back(Run(benchmark, options.batches));
+        std::println("{:<36}{:>14}{:>14.1f}{:>14.1f}{:>14.1f}", result.name, result.iterations, result.min,
+                     result.median, result.max);
+    }
+
+    if (!options.json.empty()) {
+        if (!WriteJson(options.json, results)) {
+            std::println(stderr, "Failed to write {}", options.json.string());
+            return 1;
+        }
+
+        std::println("Wrote {}", options.json.string());
+    }
+
+    return 0;
+}
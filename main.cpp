@@ -1,6 +1,8 @@
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <exception>
+#include <filesystem>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -12,11 +14,13 @@
 #include <iostream>
 #include <memory>
 #include <print>
+#include <span>
+#include <string>
 
 #include <glm/ext/matrix_transform.hpp>
+#include <iterator>
 #include <vector>
 #include <glm/ext/quaternion_geometric.hpp>
-#include <graphics/buffers/DepthBuffer.h>
 
 #include "Config.h"
 
@@ -44,11 +48,22 @@
 #include "renderables/objects/Scene.h"
 #include "renderables/objects/Walls.h"
 #include "utils/Lights.h"
-
-// light projection parameters
-float near_plane = 1.0F;
-float far_plane = 200.0F;
-float side_size = 580.0F;
+#include "graphics/LightClusters.h"
+#include "graphics/InstanceBatcher.h"
+#include "graphics/buffers/StaticGeometry.h"
+#include "graphics/MeshCache.h"
+#include "utils/AssetManager.h"
+#include "utils/TextureManager.h"
+#include "utils/StartupTimeline.h"
+#include "utils/Profiler.h"
+#include "utils/FrameArena.h"
+#include "utils/Allocations.h"
+#include "graphics/GpuProfiler.h"
+#include "graphics/GpuMemory.h"
+#include "Simulation.h"
+#include "StressTest.h"
+#include "Replay.h"
+#include "ecs/Systems.h"
 
 void processInput();
 
@@ -56,8 +71,20 @@ void setupApp();
 
 void setupShaders();
 
+void setupAssets();
+
 void setupPlayers();
 
+auto setupCars() -> std::vector<std::shared_ptr<BumperCar> >;
+
+auto runHeadless(const Simulation::Settings &settings) -> int;
+
+// size of the pathedPoints array in terrain.frag
+constexpr std::size_t MAX_PATHED_POINTS = 512;
+
+// every key, mouse movement and frame time goes through this so a session can be recorded or replayed
+Replay::Session session;
+
 struct Matrices {
     glm::mat4 view = Config::IDENTITY_MATRIX;
     glm::mat4 projection = Config::IDENTITY_MATRIX;
@@ -71,93 +98,56 @@ struct CameraInfo {
     glm::vec3 front = Config::ZERO_VECTOR;
 };
 
-auto main() -> int {
-    setupApp();
-    setupShaders();
-    Texture::Loader::setFlip(true);
-    setupPlayers();
-
-    ShaderManager &shaderManager = ShaderManager::GetInstance();
-    PlayerManager &playerManager = PlayerManager::GetInstance();
-
-    const Walls walls;
-    Scene scene;
-
-    const auto pathedCar = playerManager.get("Path")->getCar();
-    const auto driveable = playerManager.get("Drive")->getCar();
+auto main(const int argc, char **argv) -> int {
+    // measures from its first use, so this has to come before anything else
+    StartupTimeline &startupTimeline = StartupTimeline::GetInstance();
+    PROFILE_THREAD("Main");
 
-    const auto nonDriveable = std::make_shared<BumperCar>();
-    nonDriveable->setMode(BumperCar::Mode::NONE);
-    nonDriveable->shouldDrawPlayer(false);
+    const auto arguments = std::span(argv, static_cast<std::size_t>(argc));
 
-    const std::vector models = {
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        std::make_shared<BumperCar>(),
-        pathedCar,
-        driveable,
-    };
+    if (const auto settings = Simulation::ParseArguments(arguments); settings.has_value()) {
+        return runHeadless(*settings);
+    }
 
-    for (const auto &model: models) {
-        model->addTrackableEntity(Random::Element(models));
-        model->addTrackableEntity(PlayerManager::GetInstance().get("FPS"));
+    // without --stress these are the normal scene's counts
+    const auto stress = StressTest::ParseArguments(arguments);
+    const StressTest::Settings stressSettings = stress.value_or(StressTest::Settings{});
 
-        if (Random::Int(0, 5) == 0) {
-            model->addTrackableEntity(Random::Element(models));
-        }
-
-        if (Random::Int(0, 10) == 0) {
-            model->addTrackableEntity(Random::Element(models));
-        }
+    if (stress.has_value()) {
+        Random::Seed(stressSettings.seed);
+    }
 
-        if (Random::Int(0, 10) == 0) {
-            model->addTrackableEntity(pathedCar);
-        }
+    if (const auto replay = Replay::ParseArguments(arguments); replay.has_value() && !session.open(*replay)) {
+        return 1;
+    }
 
-        if (Random::Int(0, 25) == 0) {
-            model->setMode(BumperCar::Mode::RANDOM);
-        }
+    // a recording's seed wins, the replay has to draw the same numbers it did
+    if (const auto seed = session.getSeed(); seed.has_value()) {
+        Random::Seed(*seed);
+    }
 
-        if (Random::Int(0, 100) == 0) {
-            model->setMode(BumperCar::Mode::FOLLOW);
-        }
+    setupApp();
+    setupShaders();
+    Texture::Loader::setFlip(true);
+    setupAssets();
+    setupPlayers();
 
-        if (Random::Int(0, 50) == 0) {
-            model->setMode(BumperCar::Mode::NONE);
-            model->shouldDrawPlayer(false);
-        }
-    }
+    ShaderManager &shaderManager = ShaderManager::GetInstance();
+    PlayerManager &playerManager = PlayerManager::GetInstance();
 
-    models[0]->shouldDrawPlayer(false);
-    models[0]->setMode(BumperCar::Mode::NONE);
+    const Walls walls;
+    Scene scene(stressSettings.chunks, stressSettings.trees, stressSettings.clouds);
 
-    float angle = 0.0F;
-    const float angleIncrement = glm::radians(360.0F / static_cast<float>(models.size()));
+    auto models = setupCars();
 
-    for (const auto &i: models) {
-        constexpr float radius = 30.0F;
-        const float xPos = 0.0F + radius * glm::cos(angle);
-        const float zPos = 0.0F + radius * glm::sin(angle);
-        constexpr float yPos = 10.0F;
-        const auto translation = glm::vec3(xPos, yPos, zPos);
-        glm::mat4 model = translate(Config::IDENTITY_MATRIX, translation);
-        model = scale(model, glm::vec3(4.0F));
-        i->transform(model);
-        i->attributes.scale = glm::vec3(4.0F);
+    const auto extraCars = StressTest::SpawnCars(stressSettings, models.size());
+    models.insert(models.end(), extraCars.begin(), extraCars.end());
 
-        angle += angleIncrement;
-    }
+    StressTest::Recorder recorder(stressSettings);
 
     ParticleSystem &particleSystem = ParticleSystem::GetInstance();
-    ShadowBuffer shadowBuffer(10000, 10000);
-    DepthBuffer viewBuffer(App::view.getWidth(), App::view.getHeight());
-    // DepthBuffer viewBuffer(10000, 10000);
+    InstanceBatcher &instanceBatcher = InstanceBatcher::GetInstance();
+    ShadowBuffer shadowBuffer(2048);
 
     std::vector<glm::vec3> pathPoints;
 
@@ -165,9 +155,20 @@ auto main() -> int {
         pathPoints.insert(pathPoints.end(), model->getPoints().begin(), model->getPoints().end());
     }
 
+    // anything past the terrain shader's array would be dropped anyway
+    pathPoints.resize(std::min(pathPoints.size(), MAX_PATHED_POINTS));
+
+    // built once, formatting them every frame was hundreds of heap strings
+    std::vector<std::string> pathPointNames;
+    pathPointNames.reserve(pathPoints.size());
+
+    for (std::size_t i = 0; i < pathPoints.size(); i++) {
+        pathPointNames.push_back("pathedPoints[" + std::to_string(i) + "]");
+    }
+
     auto shader = scene.getTerrain()->getShader();
     for (std::size_t i = 0; i < pathPoints.size(); i++) {
-        shader->setUniform("pathedPoints[" + std::to_string(i) + "]", pathPoints[i]);
+        shader->setUniform(pathPointNames[i], pathPoints[i]);
     }
 
     shader->setUniform("pathedPointsCount", static_cast<int>(pathPoints.size()));
@@ -182,23 +183,26 @@ auto main() -> int {
 
     entities.push_back(scene.getFerrisWheel());
 
+    Simulation::World world{models, entities, scene.getTerrain(), walls.getWalls()};
+    Simulation::Link(world);
+
+    StressTest::PlaceEmitters(stressSettings, *scene.getTerrain(), world.registry);
+
 
     // matrices ubo setup
-    GLuint matricesUBO;
-    glGenBuffers(1, &matricesUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(Matrices), nullptr, GL_STATIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, matricesUBO);
+    UniformBuffer matricesUBO(sizeof(Matrices), GL_STATIC_DRAW, "Matrices");
+    matricesUBO.bindBase(0);
 
     Matrices matrices;
 
-    Lights lights;
+    UniformBuffer lightsUBO(sizeof(Lights), GL_DYNAMIC_DRAW, "Lights");
+    Lights lights{};
+    LightClusters lightClusters;
+
+    UniformBuffer shadowsUBO(sizeof(ShadowBuffer::Cascades), GL_DYNAMIC_DRAW, "Shadow cascades");
 
-    GLuint cameraUBO;
-    glGenBuffers(1, &cameraUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraInfo), nullptr, GL_STATIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 2, cameraUBO);
+    UniformBuffer cameraUBO(sizeof(CameraInfo), GL_STATIC_DRAW, "Camera");
+    cameraUBO.bindBase(2);
 
     CameraInfo cameraInfo;
 
@@ -210,15 +214,24 @@ auto main() -> int {
 
         const auto cameraIndex = glGetUniformBlockIndex(shader->getProgramID(), "Camera");
         glUniformBlockBinding(shader->getProgramID(), cameraIndex, 2);
+
+        lightsUBO.bindToShader(LIGHTS_BINDING, shader->getProgramID(), "Lights");
+        shadowsUBO.bindToShader(SHADOWS_BINDING, shader->getProgramID(), "Shadows");
     }
 
+    // the post processor owns its own shader outside of the manager
+    lightsUBO.bindToShader(LIGHTS_BINDING, App::view.getPostProcessor().getShader()->getProgramID(), "Lights");
+
+    startupTimeline.finish();
+
     App::view.setPipeline([&] {
+        // textures decoded since last frame replace their placeholders
+        TextureManager::GetInstance().update();
+
         View::clearTarget(Color::BLACK);
         const auto player = playerManager.getCurrent();
         const auto projectionMatrix = player->getCamera().
                 getProjectionMatrix();
-        const auto projectionMatrixDepth = player->getCamera().
-                getProjectionDepthMatrix();
 
         const auto viewMatrix = player->getCamera().getViewMatrix();
         const auto sunPos = scene.getSkybox()->getSun().getPosition();
@@ -233,316 +246,276 @@ auto main() -> int {
         cameraInfo.right = viewRight;
         cameraInfo.front = viewDir;
 
-        glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraInfo), &cameraInfo);
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        cameraUBO.update(&cameraInfo);
 
-        // shadow pass
-        shadowBuffer.bind();
+        {
+            PROFILE_GPU(shadowBuffer.getPassName());
 
-        const auto lightProjection = glm::ortho(-side_size, side_size, -side_size, side_size, near_plane, far_plane);
-        const auto lightView = lookAt(sunPos / 20.0F, glm::vec3(0.0F), glm::vec3(0.0F, 1.0F, 0.0F));
-        const auto lightSpaceMatrix = lightProjection * lightView;
+            shadowBuffer.update(player->getCamera(), sunPos);
+            shadowsUBO.update(&shadowBuffer.getCascades());
 
-        matrices.view = lightView;
-        matrices.projection = lightProjection;
-        matrices.lightSpaceMatrix = lightSpaceMatrix;
+            shadowBuffer.bind();
 
-        glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Matrices), &matrices);
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            shader = shaderManager.get("Shadow");
 
+            const auto drawStaticCasters = [&] {
+                scene.getTerrain()->getTrees().draw();
+                scene.drawStatic(shader);
+            };
 
-        shader = shaderManager.get("Shadow");
-        shader->use();
+            for (unsigned int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+                matrices.view = shadowBuffer.getLightView(cascade);
+                matrices.projection = shadowBuffer.getLightProjection(cascade);
+                matrices.lightSpaceMatrix = shadowBuffer.getCascades().lightSpaceMatrices[cascade];
 
-        for (const auto &model: models) {
-            if (model->hasExploded()) {
-                continue;
-            }
-            model->draw(shader);
-        }
+                matricesUBO.update(&matrices);
 
-        for (const auto &[name, player]: playerManager.getAll()) {
-            player->draw(shader);
-        }
+                // static casters only need drawing when the cached layer was refit or invalidated
+                if (shadowBuffer.bindStatic(cascade)) {
+                    drawStaticCasters();
+                }
+
+                shadowBuffer.bindCascade(cascade);
 
-        scene.getTerrain()->getTrees().draw();
-        scene.getTerrain()->getClouds().draw();
-        scene.draw(shader);
+                if (!shadowBuffer.isCaching()) {
+                    drawStaticCasters();
+                }
 
-        shadowBuffer.unbind();
+                shader->use();
 
-        viewBuffer.bind();
+                for (const auto &model: models) {
+                    if (model->hasExploded() || !shadowBuffer.isVisible(cascade, model->getBoundingBox())) {
+                        continue;
+                    }
+                    model->draw(shader);
+                }
 
-        DepthBuffer::Clear();
+                instanceBatcher.flush();
 
-        matrices.view = viewMatrix;
-        matrices.projection = projectionMatrixDepth;
+                for (const auto &[name, player]: playerManager.getAll()) {
+                    if (shadowBuffer.isVisible(cascade, player->getBoundingBox())) {
+                        player->draw(shader);
+                    }
+                }
+
+                scene.getTerrain()->getClouds().draw();
+                scene.drawDynamic(shader);
+            }
 
-        glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Matrices), &matrices);
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            shadowBuffer.unbind();
+        }
 
         lights.sun.direction = scene.getSkybox()->getSun().getDirection();
         lights.sun.ambient = scene.getSkybox()->getSun().getAmbient();
         lights.sun.diffuse = scene.getSkybox()->getSun().getDiffuse();
         lights.sun.specular = scene.getSkybox()->getSun().getSpecular();
 
-        auto pointLights = scene.getLightObjects()->getPointLights();
+        const auto &sceneLights = scene.getLightObjects()->getPointLights();
 
-
-        shader->use();
+        // rebuilt every frame, so it lives in the frame arena
+        FrameArena::Vector<PointLight> pointLights(FrameArena::GetInstance().resource());
+        pointLights.reserve(sceneLights.size() + models.size() + stressSettings.fires);
+        pointLights.assign(sceneLights.begin(), sceneLights.end());
 
         for (const auto &model: models) {
-            model->draw(shader);
-
-            if (model->isOnFire() && pointLights.size() < MAX_POINT_LIGHTS) {
+            if (model->isOnFire()) {
                 pointLights.push_back(model->getPointLight());
             }
         }
 
-        for (int i = 0; i < pointLights.size(); i++) {
-            lights.pointLight[i] = pointLights[i];
-        }
-
-        lights.pointLightCount = static_cast<int>(pointLights.size());
+        ECS::Systems::Lights(world.registry, pointLights);
 
-        playerManager.draw(shader);
+        lightClusters.update(pointLights, viewMatrix, projectionMatrix, player->getCamera().getNear(),
+                             player->getCamera().getRenderDistance(), static_cast<float>(App::view.getWidth()),
+                             static_cast<float>(App::view.getHeight()));
+        lightClusters.fill(lights);
 
+        matrices.view = viewMatrix;
+        matrices.projection = projectionMatrix;
+        matrices.lightSpaceMatrix = shadowBuffer.getCascades().lightSpaceMatrices[0];
 
-        scene.getTerrain()->getTrees().draw();
-        scene.getTerrain()->getClouds().draw();
-        scene.draw(shader);
+        matricesUBO.update(&matrices);
 
-        viewBuffer.unbind();
+        {
+            PROFILE_GPU("Scene pass");
 
-        matrices.view = viewMatrix;
-        matrices.projection = projectionMatrix;
-        matrices.lightSpaceMatrix = lightSpaceMatrix;
+            View::clearTarget(Color::BLACK);
 
-        glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Matrices), &matrices);
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            const auto texture = shadowBuffer.getTexture();
+            glActiveTexture(GL_TEXTURE10);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
 
-        View::clearTarget(Color::BLACK);
+            lightsUBO.update(&lights);
+            lightClusters.bind();
 
-        auto texture = shadowBuffer.getTexture();
-        glActiveTexture(GL_TEXTURE10);
-        glBindTexture(GL_TEXTURE_2D, texture);
+            for (const auto &[name, shader]: shaderManager.getAll()) {
+                shader->use();
+                shader->setUniform("shadowMap", 10);
+                shader->setUniform("pointLightBuffer", POINT_LIGHT_UNIT);
+                shader->setUniform("clusterGridBuffer", CLUSTER_GRID_UNIT);
+                shader->setUniform("clusterIndexBuffer", CLUSTER_INDEX_UNIT);
 
-        for (const auto &[name, shader]: shaderManager.getAll()) {
-            shader->use();
-            shader->setUniform("shadowMap", 10);
-            shader->setUniform("lights.sun.direction", lights.sun.direction);
-            shader->setUniform("lights.sun.ambient", lights.sun.ambient);
-            shader->setUniform("lights.sun.diffuse", lights.sun.diffuse);
-            shader->setUniform("lights.sun.specular", lights.sun.specular);
-            shader->setUniform("lights.pointLightsCount", lights.pointLightCount);
-
-            for (int i = 0; i < lights.pointLightCount; i++) {
-                shader->setUniform("lights.pointLights[" + std::to_string(i) + "].position",
-                                   lights.pointLight[i].position);
-                shader->setUniform("lights.pointLights[" + std::to_string(i) + "].ambient",
-                                   lights.pointLight[i].ambient);
-                shader->setUniform("lights.pointLights[" + std::to_string(i) + "].diffuse",
-                                   lights.pointLight[i].diffuse);
-                shader->setUniform("lights.pointLights[" + std::to_string(i) + "].specular",
-                                   lights.pointLight[i].specular);
-                shader->setUniform("lights.pointLights[" + std::to_string(i) + "].constant",
-                                   lights.pointLight[i].constant);
-                shader->setUniform("lights.pointLights[" + std::to_string(i) + "].linear",
-                                   lights.pointLight[i].linear);
-                shader->setUniform("lights.pointLights[" + std::to_string(i) + "].quadratic",
-                                   lights.pointLight[i].quadratic);
+                if (!App::paused) {
+                    shader->setUniform("time", App::view.getTime());
+                }
             }
 
-            if (!App::paused) {
-                shader->setUniform("time", App::view.getTime());
+            for (const auto &model: models) {
+                model->draw();
             }
-        }
 
-        for (const auto &model: models) {
-            model->draw();
-        }
+            instanceBatcher.flush();
 
-        if (player->getMode() != Player::Mode::DRIVE && player->getMode() != Player::Mode::PATH) {
-            particleSystem.draw();
-        }
+            if (player->getMode() != Player::Mode::DRIVE && player->getMode() != Player::Mode::PATH) {
+                particleSystem.draw();
+            }
 
-        playerManager.draw();
+            playerManager.draw();
 
-        shader = scene.getTerrain()->getShader();
-        shader->use();
-        shader->setUniform(
-            "pathDarkness", models[1]->getLaps() / 1000.0F);
-        for (std::size_t i = 0; i < pathPoints.size(); i++) {
-            shader->setUniform("pathedPoints[" + std::to_string(i) + "]", pathPoints[i]);
-        }
-        shader->setUniform("pathedPointsCount", static_cast<int>(pathPoints.size()));
+            shader = scene.getTerrain()->getShader();
+            shader->use();
+            shader->setUniform(
+                "pathDarkness", models[1]->getLaps() / 1000.0F);
+            for (std::size_t i = 0; i < pathPoints.size(); i++) {
+                shader->setUniform(pathPointNames[i], pathPoints[i]);
+            }
+            shader->setUniform("pathedPointsCount", static_cast<int>(pathPoints.size()));
 
-        shader = shaderManager.get("Untextured");
-        shader->use();
-        shader->setUniform("color", glm::vec3(1.0F, 1.0F, 1.0F));
-        scene.draw();
-        walls.draw();
+            shader = shaderManager.get("Untextured");
+            shader->use();
+            shader->setUniform("color", glm::vec3(1.0F, 1.0F, 1.0F));
+            scene.draw();
+            walls.draw();
+        }
 
 
         if (App::view.highQuality) {
+            PROFILE_GPU("Grass");
+
             shader = shaderManager.get("Grass");
             scene.getTerrain()->draw(shader);
         }
+    });
 
+    App::view.setInterface([&] {
+        if (App::paused) {
+            // switches go through the session so they're recorded, the rest can't change while it's in use
+            const bool tuning = session.getMode() == Replay::Mode::NONE;
+            const bool replaying = session.getMode() == Replay::Mode::REPLAY;
 
-        texture = viewBuffer.getTexture();
-        shader = shaderManager.get("PostProcess");
-        shader->use();
+            ImGui::BeginDisabled(!tuning);
+            playerManager.getCurrent()->getCamera().interface();
+            ImGui::EndDisabled();
 
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, texture);
+            ImGui::BeginDisabled(replaying);
+            if (const auto picked = playerManager.interface(); picked.has_value()) {
+                const auto names = playerManager.getNames();
+                const auto index = std::distance(names.begin(), std::ranges::find(names, *picked));
+                session.request(Replay::Change::PLAYER, static_cast<std::int32_t>(index));
+            }
 
-        shader->setUniform("depthTexture", 1);
+            if (const auto thirdPerson = playerManager.getCurrent()->interface(tuning); thirdPerson.has_value()) {
+                session.request(Replay::Change::THIRD_PERSON, *thirdPerson ? 1 : 0);
+            }
 
-        // App::view.getPostProcessor().setTexture(texture);
-    });
+            if (const auto paused = BumperCar::Interface(tuning); paused.has_value()) {
+                session.request(Replay::Change::CARS_PAUSED, *paused ? 1 : 0);
+            }
+            ImGui::EndDisabled();
 
-    App::view.setInterface([&] {
-        if (App::paused) {
-            playerManager.getCurrent()->getCamera().interface();
-            playerManager.interface();
-            playerManager.getCurrent()->interface();
             App::view.optionsInterface();
-            BumperCar::Interface();
 
             App::debugInterface();
             scene.getSkybox()->getSun().interface();
             particleSystem.interface();
-
-            ImGui::Begin("Shadow Buffer");
-            ImGui::SliderFloat("Near Plane", &near_plane, 0.0F, 10.0F);
-            ImGui::SliderFloat("Far Plane", &far_plane, 0.0F, 10000.0F);
-            ImGui::SliderFloat("Side Size", &side_size, 0.0F, 10000.0F);
-            ImGui::End();
+            lightClusters.interface();
+            instanceBatcher.interface();
+            StaticGeometry::GetInstance().interface();
+            MeshCache::Interface();
+            AssetManager::GetInstance().interface();
+            TextureManager::GetInstance().interface();
+            startupTimeline.interface();
+            Profiler::Interface();
+            Allocations::Interface();
+            FrameArena::GetInstance().interface();
+            GpuProfiler::GetInstance().interface();
+            GpuMemory::Interface();
+
+            shadowBuffer.interface();
         }
 
         if (App::debug) {
             playerManager.getCurrent()->debug();
             ShaderManager::GetInstance().interface();
-            ImGui::Begin("Shadow Buffer");
-            ImGui::Image(reinterpret_cast<void *>(shadowBuffer.getTexture()), ImVec2(200, 200));
-            ImGui::End();
             ImGui::Begin("View Buffer");
-            ImGui::Image(reinterpret_cast<void *>(viewBuffer.getTexture()), ImVec2(200, 200));
+            ImGui::Image(reinterpret_cast<void *>(App::view.getPostProcessor().getFrameBuffer()->getDepthTexture()),
+                         ImVec2(200, 200));
             ImGui::End();
         }
     });
 
     try {
         App::loop([&] {
-            const auto player = playerManager.getCurrent();
-
-            for (const auto &model: models) {
-                model->clearTrackablePositions();
-
-                if (model == player->getCar() && player->getMode() != Player::Mode::DUEL) {
-                    continue;
-                }
-
-                if (Physics::Collisions::check(*player, *model)) {
-                    if (model == player->getCar()) {
-                        player->startDriving(true);
-                    }
-
-                    const auto collisionPoint = Physics::Collisions::getCollisionPoint(*player, *model);
-                    Physics::Collisions::resolve(*player, *model, collisionPoint);
-
-                    player->collisionResponse();
-                    if (player->getMode() != Player::Mode::FREE) {
-                        model->collisionResponse();
-                    }
-
-                    particleSystem.generate(player->attributes.position - collisionPoint,
-                                            player->attributes.velocity, Color::SILVER);
-                } else {
-                    player->attributes.isColliding = false;
-                    model->attributes.isColliding = false;
-                }
-            }
-
-            particleSystem.update(App::view.getDeltaTime());
+            ECS::Systems::Emit(world.registry);
             scene.update(App::view.getDeltaTime());
+            Simulation::Step(world, App::view.getDeltaTime());
 
-            for (int i = 0; i < models.size(); i++) {
-                for (int j = i + 1; j < models.size(); j++) {
-                    if (Physics::Collisions::check(*models[i], *models[j])) {
-                        const auto collisionPoint = Physics::Collisions::getCollisionPoint(*models[i], *models[j]);
-                        Physics::Collisions::resolve(*models[i], *models[j], collisionPoint);
-
-                        particleSystem.generate(models[i]->attributes.position - collisionPoint,
-                                                models[i]->attributes.velocity, Color::SILVER);
-
-                        models[i]->collisionResponse();
-                        models[j]->collisionResponse();
-                    } else {
-                        models[i]->attributes.isColliding = false;
-                        models[j]->attributes.isColliding = false;
-                    }
-                }
-            }
-
-            for (const auto &[name, player]: playerManager.getAll()) {
-                if (Physics::Collisions::check(*player, *scene.getTerrain())) {
-                    Physics::Collisions::resolve(*player, *scene.getTerrain());
-                    player->attributes.isGrounded = true;
-                } else {
-                    player->attributes.isGrounded = false;
-                }
-            }
-
-            for (const auto &model: models) {
-                if (Physics::Collisions::check(*model, *scene.getTerrain())) {
-                    Physics::Collisions::resolve(*model, *scene.getTerrain());
-                    model->attributes.isGrounded = true;
-                } else {
-                    model->attributes.isGrounded = false;
-                }
-            }
-
-            for (const Walls::Wall &wall: walls.getWalls()) {
-                if (Physics::Collisions::check(player->getBoundingBox(), wall.box)) {
-                    Physics::Collisions::resolve(*player, wall.normal);
-                }
-            }
-
-            for (const auto &model: models) {
-                for (const Walls::Wall &wall: walls.getWalls()) {
-                    if (Physics::Collisions::check(model->getBoundingBox(), wall.box)) {
-                        Physics::Collisions::resolve(*model, wall.normal);
-                    }
-                }
-            }
-
-            for (const auto &enitity: entities) {
-                enitity->update(App::view.getDeltaTime());
+            if (stress.has_value() && recorder.frame(App::view.getFrameTime(), world.timings)) {
+                recorder.report();
+                App::view.close();
             }
         });
     } catch (const std::exception &e) {
         std::println(stderr, "{}", e.what());
     }
 
+    if (session.getMode() != Replay::Mode::NONE) {
+        session.save();
+        // matches between a recording and its replay when both simulated the same thing
+        std::println("Checksum: {:016x}", Simulation::Checksum(world));
+    }
+
     App::quit();
 }
 
 void processInput() {
     bool moved = false;
     PlayerManager &playerManager = PlayerManager::GetInstance();
+
+    // made in the pause menu last frame, or read from the log, before anything below looks at the player
+    for (const Replay::Event &event: session.getEvents()) {
+        switch (event.change) {
+            case Replay::Change::PLAYER:
+                if (const auto names = playerManager.getNames();
+                    event.value >= 0 && static_cast<std::size_t>(event.value) < names.size()) {
+                    playerManager.setCurrent(names[static_cast<std::size_t>(event.value)]);
+                }
+                break;
+            case Replay::Change::THIRD_PERSON:
+                playerManager.getCurrent()->isThirdPerson(event.value != 0);
+                break;
+            case Replay::Change::CARS_PAUSED:
+                BumperCar::SetPaused(event.value != 0);
+                break;
+        }
+    }
+
     const std::shared_ptr<Player> player = playerManager.getCurrent();
 
-    if (App::view.getKey(GLFW_KEY_ESCAPE) == GLFW_PRESS || App::view.getKey(GLFW_KEY_Q) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_ESCAPE) || session.key(GLFW_KEY_Q) || session.isFinished()) {
         App::view.close();
     }
 
-    if (App::view.getKey(GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS) {
+    // movement from the callbacks since the last frame, applied here so a replay lands on the same frame
+    if (const auto mouse = session.getMouse(); !App::paused && (mouse.x != 0.0F || mouse.y != 0.0F)) {
+        player->getCamera().processMouseMovement(mouse.x, mouse.y);
+    }
+
+    if (session.getScroll() != 0.0F) {
+        player->getCamera().processMouseScroll(session.getScroll());
+    }
+
+    if (session.key(GLFW_KEY_LEFT_CONTROL)) {
         App::setPaused(!App::paused);
     }
 
@@ -551,25 +524,25 @@ void processInput() {
         return;
     }
 
-    if (App::view.getKey(GLFW_KEY_W) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_W)) {
         moved = true;
         player->processKeyboard(Player::Direction::FORWARD,
                                 App::view.getDeltaTime());
     }
 
-    if (App::view.getKey(GLFW_KEY_S) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_S)) {
         moved = true;
         player->processKeyboard(Player::Direction::BACKWARD,
                                 App::view.getDeltaTime());
     }
 
-    if (App::view.getKey(GLFW_KEY_A) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_A)) {
         moved = true;
         player->processKeyboard(Player::Direction::LEFT,
                                 App::view.getDeltaTime());
     }
 
-    if (App::view.getKey(GLFW_KEY_D) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_D)) {
         moved = true;
         player->processKeyboard(Player::Direction::RIGHT,
                                 App::view.getDeltaTime());
@@ -580,38 +553,41 @@ void processInput() {
                                 App::view.getDeltaTime());
     }
 
-    if (App::view.getKey(GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_LEFT_SHIFT)) {
         player->processKeyboard(Player::Direction::DOWN,
                                 App::view.getDeltaTime());
     }
 
-    if (App::view.getKey(GLFW_KEY_SPACE) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_SPACE)) {
         player->processKeyboard(Player::Direction::UP,
                                 App::view.getDeltaTime());
     }
 
-    if (App::view.getKey(GLFW_KEY_N) == GLFW_PRESS) {
+    if (session.key(GLFW_KEY_N)) {
         player->nitro();
     }
 }
 
 void setupApp() {
+    const StartupTimeline::Scope scope("Window");
+
     App::window("Coursework", Config::DEFAULT_WIDTH, Config::DEFAULT_HEIGHT);
     App::init();
 
     PlayerManager &playerManager = PlayerManager::GetInstance();
 
     App::view.setKey(processInput);
-    App::view.setMouse([&] {
-        if (!App::paused) {
-            playerManager.getCurrent()->getCamera().processMouseMovement(
-                App::view.getMouseOffsetX(), App::view.getMouseOffsetY());
-        }
+    App::view.setClock([](const float measured) {
+        return session.frame(measured);
     });
 
-    App::view.setScroll([&] {
-        playerManager.getCurrent()->getCamera().processMouseScroll(
-            App::view.getScrollY());
+    // held by the session and applied in processInput
+    App::view.setMouse([] {
+        session.mouse(App::view.getMouseOffsetX(), App::view.getMouseOffsetY());
+    });
+
+    App::view.setScroll([] {
+        session.scroll(App::view.getScrollY());
     });
 
     App::view.setResize([&] {
@@ -623,6 +599,8 @@ void setupApp() {
 }
 
 void setupShaders() {
+    const StartupTimeline::Scope scope("Shaders");
+
     ShaderManager &shaderManager = ShaderManager::GetInstance();
 
     shaderManager.add("Simple", "../Assets/shaders/terrain.vert", "../Assets/shaders/terrain.frag");
@@ -647,7 +625,34 @@ void setupShaders() {
     shader->setUniform("depthTexture", 1);
 }
 
+void setupAssets() {
+    const StartupTimeline::Scope scope("Models");
+
+    // every model the scene, players and cars use, imported together so the slow ones overlap
+    const std::vector<std::filesystem::path> paths = {
+        "../Assets/objects/bumpercar1/bumper-car.obj",
+        "../Assets/objects/person-sitting/person.obj",
+        "../Assets/objects/person-sitting/bodyless.obj",
+        "../Assets/objects/person/person2.obj",
+        "../Assets/objects/sun/sun.obj",
+        "../Assets/objects/moon/moon.obj",
+        "../Assets/objects/ferris/ferris-static.obj",
+        "../Assets/objects/ferris/ferris-moving.obj",
+        "../Assets/objects/ferris/ferris-cart.obj",
+        "../Assets/objects/enterance/enterance.obj",
+        "../Assets/objects/rollercoaster/coaster.obj",
+        "../Assets/objects/barrier/Concrete-Barrier_04.obj",
+        "../Assets/objects/lights/bulb.obj",
+        "../Assets/objects/tree/tree.obj",
+        "../Assets/objects/clouds/cloud.obj",
+    };
+
+    AssetManager::GetInstance().preload(paths);
+}
+
 void setupPlayers() {
+    const StartupTimeline::Scope scope("Players");
+
     PlayerManager &playerManager = PlayerManager::GetInstance();
 
     const auto orbit = std::make_shared<Player>(Player::Mode::ORBIT);
@@ -681,3 +686,104 @@ void setupPlayers() {
 
     playerManager.setCurrent("Free");
 }
+
+auto setupCars() -> std::vector<std::shared_ptr<BumperCar> > {
+    const auto carsStart = StartupTimeline::Clock::now();
+
+    PlayerManager &playerManager = PlayerManager::GetInstance();
+
+    const auto pathedCar = playerManager.get("Path")->getCar();
+    const auto driveable = playerManager.get("Drive")->getCar();
+
+    const auto nonDriveable = std::make_shared<BumperCar>();
+    nonDriveable->setMode(BumperCar::Mode::NONE);
+    nonDriveable->shouldDrawPlayer(false);
+
+    std::vector models = {
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        std::make_shared<BumperCar>(),
+        pathedCar,
+        driveable,
+    };
+
+    StartupTimeline::GetInstance().record("Bumper cars", carsStart, StartupTimeline::Clock::now());
+
+    for (const auto &model: models) {
+        model->addTrackableEntity(Random::Element(models).get());
+        model->addTrackableEntity(PlayerManager::GetInstance().get("FPS").get());
+
+        if (Random::Int(0, 5) == 0) {
+            model->addTrackableEntity(Random::Element(models).get());
+        }
+
+        if (Random::Int(0, 10) == 0) {
+            model->addTrackableEntity(Random::Element(models).get());
+        }
+
+        if (Random::Int(0, 10) == 0) {
+            model->addTrackableEntity(pathedCar.get());
+        }
+
+        if (Random::Int(0, 25) == 0) {
+            model->setMode(BumperCar::Mode::RANDOM);
+        }
+
+        if (Random::Int(0, 100) == 0) {
+            model->setMode(BumperCar::Mode::FOLLOW);
+        }
+
+        if (Random::Int(0, 50) == 0) {
+            model->setMode(BumperCar::Mode::NONE);
+            model->shouldDrawPlayer(false);
+        }
+    }
+
+    models[0]->shouldDrawPlayer(false);
+    models[0]->setMode(BumperCar::Mode::NONE);
+
+    float angle = 0.0F;
+    const float angleIncrement = glm::radians(360.0F / static_cast<float>(models.size()));
+
+    for (const auto &i: models) {
+        constexpr float radius = 30.0F;
+        const float xPos = 0.0F + radius * glm::cos(angle);
+        const float zPos = 0.0F + radius * glm::sin(angle);
+        constexpr float yPos = 10.0F;
+        const auto translation = glm::vec3(xPos, yPos, zPos);
+        glm::mat4 model = translate(Config::IDENTITY_MATRIX, translation);
+        model = scale(model, glm::vec3(4.0F));
+        i->transform(model);
+        i->attributes.scale = glm::vec3(4.0F);
+
+        angle += angleIncrement;
+    }
+
+    return models;
+}
+
+auto runHeadless(const Simulation::Settings &settings) -> int {
+    // has to be set before anything is built, the constructors check it instead of touching gl
+    App::headless = true;
+    Random::Seed(settings.seed);
+
+    setupPlayers();
+
+    const auto cars = setupCars();
+    const Walls walls;
+
+    Simulation::World world{cars, {cars.begin(), cars.end()}, std::make_shared<ProceduralTerrain>(), walls.getWalls()};
+    Simulation::Link(world);
+
+    for (const auto &[name, player]: PlayerManager::GetInstance().getAll()) {
+        world.entities.push_back(player);
+    }
+
+    return Simulation::RunHeadless(world, settings);
+}